@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Cardia.hpp>
+
+
+// Drives a scene of sprites and meshes through Scene and Renderer2D, without ImGui so it runs with --headless and --null-renderer.
+// With --null-renderer each frame is checked against what the backend recorded, the run exits with 1 on the first wrong frame.
+class SceneBenchmark : public Cardia::Application
+{
+public:
+	SceneBenchmark();
+
+	void OnUpdate() override;
+	void OnEvent(Cardia::Event& event) override;
+	void OnImGuiDraw() override {}
+	Cardia::Scene* GetCurrentScene() override { return &m_Scene; }
+
+private:
+	// Needs Renderer2D and the mesh pool, which only exist once Run started
+	void populate();
+	static std::shared_ptr<Cardia::Mesh> createCube();
+	// Checks the frame recorded before this one, the last frame of a run is only part of the totals Run logs
+	void checkRecordedFrame();
+	void onResize(const Cardia::WindowResizeEvent& e);
+
+	Cardia::Scene m_Scene { std::string("Benchmark") };
+	Cardia::SceneCamera m_Camera;
+	glm::mat4 m_CameraTransform { 1.0f };
+	std::vector<Cardia::Entity> m_MovingSprites;
+	bool m_Populated = false;
+	Cardia::NullRenderCounters m_LastCounters {};
+	uint64_t m_PopulateUploadedBytes = 0; // Recorded by the first frame, every sprite and mesh is uploaded then
+	uint32_t m_FrameIndex = 0;
+	float m_Time = 0.0f;
+};
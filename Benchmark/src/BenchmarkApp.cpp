@@ -0,0 +1,9 @@
+#include "SceneBenchmark.hpp"
+
+#include <Cardia/EntryPoint.hpp>
+
+
+std::unique_ptr<Cardia::Application> Cardia::CreateApplication()
+{
+	return std::make_unique<SceneBenchmark>();
+}
@@ -0,0 +1,172 @@
+#include "SceneBenchmark.hpp"
+
+#include <Cardia.hpp>
+#include <array>
+
+
+namespace
+{
+	constexpr int spriteGridSize = 128; // Wider than the camera, the outer sprites get culled
+	constexpr int movingSpriteStride = 16; // One sprite in that many is moved each frame
+	constexpr int translucentSpriteStride = 8;
+	constexpr int meshGridSize = 8;
+	constexpr int textureCount = 4;
+}
+
+SceneBenchmark::SceneBenchmark()
+{
+	m_Camera.SetOrthographic(80.0f, -10.0f, 10.0f);
+	m_Camera.SetViewportSize(static_cast<float>(getWindow().getWidth()), static_cast<float>(getWindow().getHeight()));
+}
+
+void SceneBenchmark::populate()
+{
+	std::array<std::shared_ptr<Cardia::Texture2D>, textureCount> textures;
+	for (int i = 0; i < textureCount; i++)
+	{
+		// Checkers of a different color each, the benchmark ships no resources of its own
+		std::array<uint32_t, 16 * 16> pixels {};
+		for (int y = 0; y < 16; y++)
+			for (int x = 0; x < 16; x++)
+				pixels[y * 16 + x] = (x + y) % 2 ? 0xFFFFFFFF : (0xFF000000 | 0xFFu << (i % 3 * 8));
+		textures[i] = Cardia::Texture2D::create(16, 16, pixels.data());
+	}
+
+	const float halfGrid = static_cast<float>(spriteGridSize) / 2.0f;
+	for (int y = 0; y < spriteGridSize; y++)
+	{
+		for (int x = 0; x < spriteGridSize; x++)
+		{
+			const int index = y * spriteGridSize + x;
+			auto sprite = m_Scene.CreateEntity("Sprite");
+			sprite.getComponent<Cardia::Component::Transform>().position = { static_cast<float>(x) - halfGrid, static_cast<float>(y) - halfGrid, 0.0f };
+
+			auto& spriteRenderer = sprite.addComponent<Cardia::Component::SpriteRenderer>();
+			spriteRenderer.texture = textures[index % textureCount];
+			spriteRenderer.zIndex = index % 3;
+			if (index % translucentSpriteStride == 0)
+				spriteRenderer.color.a = 0.5f;
+			if (index % movingSpriteStride == 0)
+				m_MovingSprites.push_back(sprite);
+		}
+	}
+
+	// Half the meshes use the quantized vertex format
+	const auto cube = createCube();
+	for (int i = 0; i < meshGridSize * meshGridSize; i++)
+	{
+		auto entity = m_Scene.CreateEntity("Cube");
+		auto& transform = entity.getComponent<Cardia::Component::Transform>();
+		transform.position = { static_cast<float>(i % meshGridSize) * 4.0f - 16.0f, static_cast<float>(i / meshGridSize) * 4.0f - 16.0f, 1.0f };
+		transform.scale = glm::vec3(2.0f);
+
+		auto& meshRenderer = entity.addComponent<Cardia::Component::MeshRendererC>();
+		meshRenderer.meshRenderer->SubmitMesh(cube, i % 2 ? Cardia::VertexFormat::Packed : Cardia::VertexFormat::Standard);
+	}
+}
+
+std::shared_ptr<Cardia::Mesh> SceneBenchmark::createCube()
+{
+	auto mesh = std::make_shared<Cardia::Mesh>();
+	auto& subMesh = mesh->GetSubMeshes().emplace_back();
+
+	static constexpr std::array<glm::vec3, 6> normals {{
+		{ 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+	}};
+	for (const auto& normal : normals)
+	{
+		// Two axes spanning the face, ordered so the face winds counter clockwise seen from outside
+		const glm::vec3 u = glm::vec3(normal.y, normal.z, normal.x);
+		const glm::vec3 v = glm::cross(normal, u);
+		const auto first = static_cast<uint32_t>(subMesh.GetVertices().size());
+		for (const glm::vec2 corner : { glm::vec2(-1, -1), glm::vec2(1, -1), glm::vec2(1, 1), glm::vec2(-1, 1) })
+		{
+			Cardia::Vertex vertex {};
+			vertex.position = (normal + corner.x * u + corner.y * v) * 0.5f;
+			vertex.normal = normal;
+			vertex.color = glm::vec4(1.0f);
+			vertex.textureCoord = (corner + 1.0f) * 0.5f;
+			vertex.tilingFactor = 1.0f;
+			subMesh.GetVertices().push_back(vertex);
+			subMesh.GetBounds().Expand(vertex.position);
+		}
+		for (const uint32_t index : { 0u, 1u, 2u, 2u, 3u, 0u })
+			subMesh.GetIndices().push_back(first + index);
+	}
+	mesh->GetBounds().Expand(subMesh.GetBounds());
+	return mesh;
+}
+
+void SceneBenchmark::OnUpdate()
+{
+	if (Cardia::RenderAPI::getAPI() == Cardia::RenderAPI::API::None)
+		checkRecordedFrame();
+
+	if (!m_Populated)
+	{
+		populate();
+		m_Populated = true;
+	}
+
+	// Keeps part of the retained sprites changing, the others stay uploaded
+	m_Time += Cardia::Time::deltaTime().seconds();
+	for (auto& sprite : m_MovingSprites)
+		sprite.getComponent<Cardia::Component::Transform>().rotation.z = m_Time;
+
+	Cardia::RenderThread::submit([]
+	{
+		Cardia::RenderAPI::get().setClearColor({0.2f, 0.2f, 0.2f, 1});
+		Cardia::RenderAPI::get().clear();
+	});
+	m_Scene.OnUpdateEditor(m_Camera, m_CameraTransform);
+}
+
+void SceneBenchmark::checkRecordedFrame()
+{
+	const auto counters = Cardia::NullRecorder::getCounters();
+	const Cardia::NullRenderCounters frame {
+		counters.calls - m_LastCounters.calls,
+		counters.drawCalls - m_LastCounters.drawCalls,
+		counters.dispatches - m_LastCounters.dispatches,
+		counters.uploadedBytes - m_LastCounters.uploadedBytes
+	};
+	m_LastCounters = counters;
+	// Nothing was recorded before the scene was populated
+	if (!m_Populated)
+		return;
+
+	const uint32_t frameIndex = m_FrameIndex++;
+	if (frameIndex == 0)
+		m_PopulateUploadedBytes = frame.uploadedBytes;
+
+	// Retained sprites stay uploaded, only the moving and translucent ones are streamed again
+	const bool retainedSprites = Cardia::Renderer2D::isRetainedSprites() && Cardia::Renderer2D::isInstancedSprites() && !Cardia::Renderer2D::isTopDownSorting();
+
+	const char* failure = nullptr;
+	if (frame.drawCalls == 0)
+		failure = "nothing was drawn";
+	else if (frame.uploadedBytes == 0)
+		failure = "nothing was uploaded, the moving and translucent sprites are streamed every frame";
+	else if (Cardia::Renderer2D::isGpuCulling() && frame.dispatches == 0)
+		failure = "GPU culling is enabled but nothing was dispatched";
+	else if (frameIndex > 0 && retainedSprites && frame.uploadedBytes >= m_PopulateUploadedBytes)
+		failure = "as many bytes were uploaded as when the scene was populated, retained sprites were uploaded again";
+
+	if (!failure)
+		return;
+	Cardia::Log::error("Benchmark frame {0}: {1} ({2} calls, {3} draws, {4} dispatches, {5} bytes uploaded)",
+		frameIndex, failure, frame.calls, frame.drawCalls, frame.dispatches, frame.uploadedBytes);
+	setExitCode(1);
+	close();
+}
+
+void SceneBenchmark::OnEvent(Cardia::Event& event)
+{
+	Cardia::EventDispatcher dispatcher(event);
+	dispatcher.dispatch<Cardia::WindowResizeEvent>(CD_BIND_EVENT_FN(onResize));
+}
+
+void SceneBenchmark::onResize(const Cardia::WindowResizeEvent& e)
+{
+	m_Camera.SetViewportSize(static_cast<float>(e.getW()), static_cast<float>(e.getH()));
+}
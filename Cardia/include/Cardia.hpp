@@ -22,11 +22,15 @@
 #include "Cardia/Renderer/Renderer.hpp"
 #include "Cardia/Renderer/RenderAPI.hpp"
 #include "Cardia/Renderer/Renderer2D.hpp"
+#include "Cardia/Renderer/RenderThread.hpp"
 
 #include "Cardia/Renderer/Buffer.hpp"
 #include "Cardia/Renderer/Shader.hpp"
 #include "Cardia/Renderer/VertexArray.hpp"
 #include "Cardia/Renderer/Texture.hpp"
+#include "Cardia/Renderer/TextureAtlas.hpp"
 #include "Cardia/Renderer/Framebuffer.hpp"
+#include "Cardia/Renderer/RenderGraph.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
 
 #include "Cardia/Renderer/Camera.hpp"
@@ -5,6 +5,7 @@
 #include "Cardia/Core/Time.hpp"
 #include "Cardia/Core/Window.hpp"
 #include "Cardia/ImGui/ImGuiLayer.hpp"
+#include "Cardia/Renderer/Framebuffer.hpp"
 #include "Cardia/Scripting/ScriptEngine.hpp"
 
 
@@ -26,13 +27,29 @@ namespace Cardia
 		inline static Application& get() { return *s_Instance; }
 		inline Window& getWindow() const { return *m_Window; }
 		inline void close() { m_Running = false; }
+		// Returned by main once Run ends, applications checking their own run set it on failure
+		inline void setExitCode(int code) { m_ExitCode = code; }
+		inline int getExitCode() const { return m_ExitCode; }
+
+		// Headless runs have no window nor ImGui, frames are rendered into this framebuffer, bound as each frame starts
+		inline Framebuffer* getOffscreenFramebuffer() const { return m_OffscreenFramebuffer.get(); }
+		inline static bool isHeadless() { return s_Headless; }
+
+		// Set from the command line, before the application is created
+		inline static void setHeadless(bool state) { s_Headless = state; }
+		// Run stops after that many frames and logs their average time, 0 runs until closed
+		inline static void setFrameLimit(uint32_t frames) { s_FrameLimit = frames; }
 
 	private:
 		std::unique_ptr<Window> m_Window;
 		std::unique_ptr<ImGuiLayer> m_ImGuiLayer;
+		std::unique_ptr<Framebuffer> m_OffscreenFramebuffer;
 		ScriptEngine m_ScriptEngine;
 		bool m_Running = true;
+		int m_ExitCode = 0;
 		static Application* s_Instance;
+		static inline bool s_Headless = false;
+		static inline uint32_t s_FrameLimit = 0;
 
 	};
 
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Cardia/Core/Window.hpp"
+#include "Cardia/Renderer/RendererContext.hpp"
+
+
+namespace Cardia
+{
+	// Window of a headless run: no native window, no events, only a context
+	class HeadlessWin : public Window
+	{
+	public:
+		explicit HeadlessWin(const WinProperties& properties);
+		~HeadlessWin() override = default;
+
+		void onUpdate() override;
+		inline int getWidth() const override { return m_Width; }
+		inline int getHeight() const override { return m_Height; }
+		inline std::pair<int, int> getSize() const override { return {getWidth(), getHeight()}; }
+
+		inline void setEventCallback(const std::function<void(Event&)>& callback) override {}
+		inline void setFullscreen(bool state) override {}
+		inline bool isFullscreen() const override { return false; }
+		inline void setVSync(bool state) override { m_VSync = state; }
+		inline bool isVSync() const override { return m_VSync; }
+
+		inline void* getNativeWin() const override { return nullptr; }
+		inline RendererContext& getContext() const override { return *m_RendererContext; }
+
+	private:
+		int m_Width;
+		int m_Height;
+		bool m_VSync = false; // Only remembered, there is nothing to present
+		std::unique_ptr<RendererContext> m_RendererContext;
+	};
+}
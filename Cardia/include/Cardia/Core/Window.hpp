@@ -3,6 +3,7 @@
 #include "cdpch.hpp"
 #include "Cardia/Core/Core.hpp"
 #include "Event.hpp"
+#include "Cardia/Renderer/RendererContext.hpp"
 
 
 namespace Cardia
@@ -11,11 +12,13 @@ namespace Cardia
 	{
 		int width, height;
 		std::string title;
+		bool headless; // No window, the context renders offscreen
 
 		explicit WinProperties(std::string title = "Cacardia",
 			int width = 1920,
-			int height = 1080)
-			: width(width), height(height), title(std::move(title)) {}
+			int height = 1080,
+			bool headless = false)
+			: width(width), height(height), title(std::move(title)), headless(headless) {}
 	};
 	
 	class Window
@@ -35,6 +38,7 @@ namespace Cardia
 		virtual bool isVSync() const = 0;
 
 		virtual void* getNativeWin() const = 0;
+		virtual RendererContext& getContext() const = 0;
 
 		static std::unique_ptr<Window> Create(const WinProperties& properties = WinProperties());
 
@@ -36,6 +36,7 @@ namespace Cardia
 		bool isVSync() const override;
 
 		inline virtual void* getNativeWin() const override { return m_Window; }
+		inline RendererContext& getContext() const override { return *m_RendererContext; }
 
 	private:
 		void init(const WinProperties& properties);
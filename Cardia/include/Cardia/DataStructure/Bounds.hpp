@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <glm/glm.hpp>
+
+
+namespace Cardia
+{
+	struct AABB
+	{
+		glm::vec3 min { std::numeric_limits<float>::max() };
+		glm::vec3 max { std::numeric_limits<float>::lowest() };
+
+		bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+		void Expand(const glm::vec3& point);
+		void Expand(const AABB& other);
+		// Bounds of this box once transformed, still axis aligned
+		AABB Transform(const glm::mat4& transform) const;
+	};
+
+	class Frustum
+	{
+	public:
+		// Planes are extracted from a view projection matrix with an OpenGL clip space
+		explicit Frustum(const glm::mat4& viewProjection);
+		bool Intersects(const AABB& box) const;
+		// xyz: inward normal, w: distance, ready to be uploaded for GPU culling
+		const std::array<glm::vec4, 6>& GetPlanes() const { return m_Planes; }
+
+	private:
+		std::array<glm::vec4, 6> m_Planes {};
+	};
+}
@@ -14,12 +14,15 @@ namespace Cardia
 		const std::vector<SubMesh>& GetSubMeshes() const { return  m_SubMeshes; }
 		std::vector<std::shared_ptr<Texture2D>>& GetMaterials() { return  m_Materials; }
 		const std::vector<std::shared_ptr<Texture2D>>& GetMaterials() const { return  m_Materials; }
+		AABB& GetBounds() { return m_Bounds; }
+		const AABB& GetBounds() const { return m_Bounds; }
 
 		static Mesh ReadMeshFromFile(const std::string& path);
 
 	private:
 		std::vector<std::shared_ptr<Texture2D>> m_Materials;
 		std::vector<SubMesh> m_SubMeshes {};
+		AABB m_Bounds; // Union of the sub meshes bounds
 
 	};
 }
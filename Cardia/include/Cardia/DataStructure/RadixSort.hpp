@@ -0,0 +1,25 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+
+namespace Cardia
+{
+	struct SortItem
+	{
+		uint64_t key;
+		uint32_t index;
+	};
+
+	// Stable LSD radix sort on the 64-bit keys, scratch is resized and reused between calls
+	void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+
+	// Maps a float to an unsigned key with the same ordering, negative values included
+	inline uint32_t FloatSortKey(float value)
+	{
+		const auto bits = std::bit_cast<uint32_t>(value);
+		return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+	}
+}
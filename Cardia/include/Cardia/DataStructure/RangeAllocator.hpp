@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+
+
+namespace Cardia
+{
+	// First-fit sub-allocator over [0, capacity), freed neighbours are coalesced back together
+	class RangeAllocator
+	{
+	public:
+		static constexpr uint32_t invalidOffset = std::numeric_limits<uint32_t>::max();
+
+		explicit RangeAllocator(uint32_t capacity = 0);
+
+		// Returns invalidOffset when no free range is big enough
+		uint32_t Allocate(uint32_t size);
+		void Free(uint32_t offset, uint32_t size);
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		uint32_t GetFreeSize() const { return m_FreeSize; }
+
+	private:
+		std::map<uint32_t, uint32_t> m_FreeRanges; // offset -> size
+		uint32_t m_Capacity;
+		uint32_t m_FreeSize;
+	};
+}
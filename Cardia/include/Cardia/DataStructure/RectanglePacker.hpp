@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+
+namespace Cardia
+{
+	// Skyline bottom-left packer: rectangles rest on the lowest segment of the skyline they fit on.
+	// Packing them by decreasing height leaves little space under the skyline.
+	class RectanglePacker
+	{
+	public:
+		RectanglePacker(int width, int height);
+
+		// Bottom left corner of the placed rectangle, false when there is no room left for it
+		bool Pack(int width, int height, glm::ivec2& position);
+
+		int GetWidth() const { return m_Width; }
+		int GetHeight() const { return m_Height; }
+
+	private:
+		struct Segment
+		{
+			int x;
+			int y;
+			int width;
+		};
+
+		// Height a rectangle of width would rest at from segment index, -1 when it goes past the right edge
+		int RestingHeight(size_t index, int width) const;
+
+		std::vector<Segment> m_Skyline; // Left to right, covers the whole width
+		int m_Width;
+		int m_Height;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "Vertex.hpp"
+#include "Bounds.hpp"
 
 
 namespace Cardia
@@ -16,9 +17,12 @@ namespace Cardia
 		const std::vector<uint32_t>& GetIndices() const { return  m_Indices; }
 		uint32_t& GetMaterialIndex() { return m_MaterialIndex; }
 		uint32_t GetMaterialIndex() const { return m_MaterialIndex; }
+		AABB& GetBounds() { return m_Bounds; }
+		const AABB& GetBounds() const { return m_Bounds; }
 
 	private:
 		uint32_t m_MaterialIndex = 0;
+		AABB m_Bounds; // Model space, computed at import
 		std::vector<Vertex> m_Vertices;
 		std::vector<uint32_t> m_Indices;
 	};
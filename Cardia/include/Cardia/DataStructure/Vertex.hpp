@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
 
 
 namespace Cardia
@@ -12,7 +13,8 @@ namespace Cardia
 		glm::vec4 color;
 		glm::vec2 textureCoord;
 		float tilingFactor;
-		float entityID;
+		int32_t textureIndex;
+		int32_t entityID;
 
 		/*
 		glm::vec3 position;
@@ -23,4 +25,27 @@ namespace Cardia
 		float entityID;
 		*/
 	};
+
+	// Quantized vertex, 36 bytes instead of 60. Attribute locations match Vertex so both formats share shaders.
+	struct PackedVertex
+	{
+		glm::vec3 position;
+		glm::i16vec4 normal; // snorm, w unused
+		glm::u8vec4 color; // unorm
+		glm::u16vec2 textureCoord; // half floats
+		uint16_t tilingFactor; // half float
+		uint16_t textureIndex;
+		int32_t entityID;
+	};
+
+	// Both layouts are mirrored by the vertex attribute pointers, padding would shift them
+	static_assert(sizeof(Vertex) == 60);
+	static_assert(sizeof(PackedVertex) == 36);
+
+	enum class VertexFormat
+	{
+		Standard = 0, Packed
+	};
+
+	PackedVertex PackVertex(const Vertex& vertex);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Cardia/Renderer/Texture.hpp"
+#include "Cardia/Renderer/TextureAtlas.hpp"
 #include "SceneCamera.hpp"
 #include "Cardia/Core/UUID.hpp"
 #include "Cardia/Scripting/ScriptEngine.hpp"
@@ -84,11 +85,30 @@ namespace Cardia::Component
 
 		glm::vec4 color { 1.0f };
 		std::shared_ptr<Texture2D> texture = nullptr;
-		float tillingFactor = 1.0f;
+		glm::vec4 uvRect = fullTextureRect; // Part of texture drawn, xy: offset, zw: size
+		// Set when texture is an atlas, region is the name uvRect was resolved from
+		std::shared_ptr<TextureAtlas> atlas = nullptr;
+		std::string region;
+		float tillingFactor = 1.0f; // Repeats the whole texture, keep it at 1 for atlas regions
 		int32_t zIndex = 0;
 
+		// Points the sprite at a region of atlas, false when it has no such region
+		inline bool setRegion(std::shared_ptr<TextureAtlas> regionAtlas, const std::string& name) {
+			const AtlasRegion* atlasRegion = regionAtlas ? regionAtlas->findRegion(name) : nullptr;
+			if (!atlasRegion)
+				return false;
+			texture = regionAtlas->getTexture();
+			uvRect = atlasRegion->uvRect;
+			atlas = std::move(regionAtlas);
+			region = name;
+			return true;
+		}
+
 		inline void reset() {
 			texture = nullptr;
+			uvRect = fullTextureRect;
+			atlas = nullptr;
+			region.clear();
 			tillingFactor = 1.0f;
 			color = glm::vec4(1.0f);
 		}
@@ -5,6 +5,8 @@
 #include "Cardia/Core/UUID.hpp"
 #include "Cardia/Renderer/Shader.hpp"
 #include "Cardia/Renderer/Texture.hpp"
+#include "Cardia/DataStructure/Bounds.hpp"
+#include "Cardia/Renderer/RetainedSprites.hpp"
 
 #include <entt/entt.hpp>
 #include <filesystem>
@@ -12,6 +14,12 @@
 
 namespace Cardia
 {
+	namespace Component
+	{
+		struct Transform;
+		struct SpriteRenderer;
+	}
+
 	class Entity;
 	class Scene
 	{
@@ -38,9 +46,29 @@ namespace Cardia
 		void clear();
 
 	private:
+		// Components are edited in place (inspector, gizmo, scripts), the last uploaded state is kept to spot changes
+		struct RetainedSprite
+		{
+			RetainedSprites::Handle handle;
+			glm::vec3 position;
+			glm::vec3 rotation;
+			glm::vec3 scale;
+			glm::vec4 color;
+			const Texture2D* texture;
+			glm::vec4 uvRect;
+			float tilingFactor;
+			int32_t zIndex;
+		};
+
+		void RenderScene(Camera& camera, const glm::mat4& cameraTransform);
+		bool RetainSprite(entt::entity entity, const Component::Transform& transform, const Component::SpriteRenderer& spriteRenderer);
+		void OnRetainedSpriteDestroy(entt::registry& registry, entt::entity entity);
+		void OnSpriteRendererDestroy(entt::registry& registry, entt::entity entity);
+
 		std::filesystem::path m_Path;
-		std::shared_ptr<Shader> m_BasicShader {};
 		std::string m_Name;
+		// Outlives the registry, its destroy signals release retained handles
+		RetainedSprites m_RetainedSprites;
 		entt::registry m_Registry;
 		friend class Entity;
 	};
@@ -3,14 +3,36 @@
 
 #if defined(_WIN64) || defined(__linux__)
 
+#include <string_view>
+
 extern std::unique_ptr<Cardia::Application> Cardia::CreateApplication();
 
 int main(int argc, char** argv)
 {
 	Cardia::Logger::Init();
 
+	// --headless runs without a window (Linux, EGL), --frames N stops after N frames, e.g. for benchmarks on build servers.
+	// --null-renderer runs headless without any GPU, the calls and uploads are only counted
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view argument = argv[i];
+		if (argument == "--headless")
+			Cardia::Application::setHeadless(true);
+		else if (argument == "--null-renderer")
+		{
+			Cardia::RenderAPI::setAPI(Cardia::RenderAPI::API::None);
+			Cardia::Application::setHeadless(true);
+		}
+		else if (argument == "--frames" && i + 1 < argc)
+			Cardia::Application::setFrameLimit(static_cast<uint32_t>(std::stoul(argv[++i])));
+	}
+
+	// Applications that cannot run with these options refuse them
 	const auto app = Cardia::CreateApplication();
+	if (!app)
+		return 1;
 	app->Run();
+	return app->getExitCode();
 }
 
 #endif
@@ -6,6 +6,7 @@
 #include <utility>
 #include "Cardia/Core/Core.hpp"
 #include "Cardia/Renderer/Texture.hpp"
+#include "Cardia/Renderer/TextureAtlas.hpp"
 #include "Cardia/DataStructure/Mesh.hpp"
 #include "Cardia/Renderer/Shader.hpp"
 #include "Cardia/Project/Project.hpp"
@@ -131,6 +132,23 @@ namespace Cardia
 		return std::static_pointer_cast<Texture2D>(m_Assets[id].Resource);
 	}
 
+	template<>
+	inline std::shared_ptr<TextureAtlas> AssetsManager::LoadImpl(const std::filesystem::path& path, LoadType loadType)
+	{
+		std::filesystem::path absPath = GetAbsolutePath(path, loadType);
+		TypeID id {typeid(TextureAtlas), path.string()};
+
+		if (!m_Assets.contains(id)) {
+			// The texture is an asset of its own, shared with sprites that reference it directly
+			auto texturePath = path;
+			texturePath.replace_extension(".ktx2");
+			AssetRefCounter res(TextureAtlas::load(absPath, Load<Texture2D>(texturePath, loadType)));
+			m_Assets.insert_or_assign(id, res);
+		}
+
+		return std::static_pointer_cast<TextureAtlas>(m_Assets[id].Resource);
+	}
+
 	template<>
 	inline std::shared_ptr<Mesh> AssetsManager::LoadImpl(const std::filesystem::path& path, LoadType loadType)
 	{
@@ -1,4 +1,7 @@
 ﻿#pragma once
+#include <array>
+#include <limits>
+#include <optional>
 #include <glm/vec3.hpp>
 
 #include "Cardia/DataStructure/Mesh.hpp"
@@ -10,47 +13,123 @@ namespace Cardia
 {
 
 	constexpr uint32_t maxTriangle = 100000;
-	constexpr uint32_t maxVertices = maxTriangle * 3;
-	constexpr uint32_t maxIndices = maxTriangle * 3;
-	constexpr int maxTextureSlots = 32; // TODO: get it from RenderAPI
+	// Sprites expanded on the CPU are quads of 4 vertices and 6 indices, a batch fills at most one streaming region.
+	// Renderer2D uploads a batch right before drawing it and fences the rings after, a frame can span any number of regions
+	constexpr uint32_t maxBatchQuads = 1 << 14;
+	constexpr uint32_t maxVertices = maxBatchQuads * 4;
+	constexpr uint32_t maxIndices = maxBatchQuads * 6;
+	constexpr uint32_t maxSpriteInstances = maxTriangle / 2;
+	constexpr int maxTextureSlots = 32; // Upper bound, clamped to RenderAPI::getMaxTextureSlots() per batch
+
+	// Per-instance data of the instanced sprite path, the unit quad is expanded on the GPU
+	struct SpriteInstance
+	{
+		glm::vec4 transformRows[3]; // First three rows of the affine model matrix
+		glm::vec4 color;
+		glm::vec4 uvRect; // xy: offset, zw: size
+		float tilingFactor;
+		int32_t entityID;
+		int32_t textureIndex;
+	};
 
 	struct BatchSpecification
 	{
 		int32_t layer;
 		bool alpha;
-		std::string shader;
-		std::string texture;
+		ShaderFeatures shaderFeatures = ShaderFeature::None; // Variant drawing the batch, Instanced selects the sprite path
+
+		bool isInstanced() const { return shaderFeatures & ShaderFeature::Instanced; }
+
+		// Packs the specification in a single key which is also the draw order:
+		// | layer (32, sign flipped) | alpha (1) | unused (23) | shader features (8) |
+		// The unused bits are filled by Batch::drawKey to order opaque batches by depth
+		uint64_t key() const
+		{
+			return static_cast<uint64_t>(static_cast<uint32_t>(layer) ^ 0x80000000u) << 32
+				   | static_cast<uint64_t>(alpha) << 31
+				   | static_cast<uint64_t>(shaderFeatures);
+		}
+
 		bool operator==(const BatchSpecification& other) const
 		{
-			return other.layer == layer
-				   && other.alpha == alpha
-				   && other.shader == shader
-				   && other.texture == texture;
+			return key() == other.key();
 		}
 	};
 	
+	// What drawRect submits for a sprite, shared with the retained sprite path
+	SpriteInstance MakeSpriteInstance(const glm::mat4& transform, const glm::vec4& color, const glm::vec4& uvRect, float tilingFactor, int32_t entityID);
+	BatchSpecification MakeSpriteSpecification(const Texture2D* texture, const glm::vec4& color, int32_t zIndex, bool instanced);
+
+	// Order of the meshes or sprites inside a batch
+	enum class BatchOrder
+	{
+		Submission = 0,
+		BackToFront, // Farthest from the camera first, for translucent geometry
+		FrontToBack // Nearest first, occluded opaque fragments then fail the depth test early
+	};
+
+	constexpr uint32_t spriteCullGroupSize = 256; // local_size_x of sprite_cull.comp
+	constexpr uint32_t maxSpriteCullGroups = (maxSpriteInstances + spriteCullGroupSize - 1) / spriteCullGroupSize;
+	static_assert(maxSpriteCullGroups <= spriteCullGroupSize, "sprite_cull.comp sums the group counts within one workgroup");
+
+	// GPU frustum culling of an instanced batch, owned by Renderer2D.
+	// The compute shader compacts the visible sprites and writes the indirect command drawing them
+	struct SpriteCulling
+	{
+		Shader* computeShader; // Frustum planes are already uploaded
+		VertexArray* vertexArray; // Unit quad, its instance buffer receives the visible sprites
+		IndirectBuffer* commands;
+		IndirectBuffer* groupCounts; // maxSpriteCullGroups counters, scratch between the two passes
+		uint32_t commandSlot;
+	};
+
 	class Batch
 	{
 	public:
-		Batch(VertexArray* va, const glm::vec3& cameraPosition, const Texture2D* texture, const BatchSpecification& specification);
+		Batch(VertexArray* va, const glm::vec3& cameraPosition, const Texture2D* whiteTexture, const BatchSpecification& specification);
 		void startBash();
-		void render(bool alpha = false);
-		bool addMesh(SubMesh* mesh);
+		// Uploads the batch in order, a GPU culled batch is also culled
+		void prepare(BatchOrder order = BatchOrder::Submission, const SpriteCulling* culling = nullptr);
+		// Draws the prepared batch, can be repeated with another shader (depth pre-pass)
+		void draw(Shader& shader) const;
+		// Specification key, with frontToBack opaque batches of a layer are drawn nearest first
+		uint64_t drawKey(bool frontToBack) const;
+		uint32_t getTriangleCount() const;
+		bool addMesh(SubMesh* mesh, const Texture2D* texture = nullptr);
+		bool addSprite(const SpriteInstance& sprite, const Texture2D* texture = nullptr);
 		BatchSpecification specification;
 	private:
+		void prepareMeshes(BatchOrder order);
+		void prepareInstances(BatchOrder order, const SpriteCulling* culling);
+		uint64_t orderKey(const glm::vec3& position, BatchOrder order) const;
+		void bindShaderAndTextures(Shader& shader) const;
+
 		glm::vec3 camPos {};
+		float m_NearestDistance = std::numeric_limits<float>::max(); // Squared, of the nearest mesh vertex or sprite
 
 		VertexArray* vertexArray;
 		VertexBuffer* vertexBuffer = nullptr;
 		IndexBuffer* indexBuffer = nullptr;
-		std::shared_ptr<Shader> m_Shader;
-		std::unique_ptr<Texture2D> whiteTexture;
+		VertexBuffer* instanceBuffer = nullptr;
 
 		std::vector<Vertex> vertexBufferData;
 		uint32_t indexCount = 0;
 
+		std::vector<SpriteInstance> instanceBufferData;
+
 		std::vector<std::vector<uint32_t>> indexBufferData;
 		uint32_t indexOffset {};
-		const Texture2D* m_CurrentTexture = nullptr;
+
+		int32_t getTextureSlot(const Texture2D* texture);
+
+		// Where prepare left the batch
+		uint32_t m_FirstIndex {};
+		int32_t m_BaseVertex {};
+		uint32_t m_FirstInstance {};
+		std::optional<SpriteCulling> m_Culling;
+
+		std::array<const Texture2D*, maxTextureSlots> m_TextureSlots {};
+		int32_t m_TextureSlotCount = 1; // slot 0 is always the white texture
+		int32_t m_MaxTextureSlots = maxTextureSlots;
 	};
 }
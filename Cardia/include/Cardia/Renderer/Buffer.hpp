@@ -9,7 +9,8 @@ namespace Cardia
 	enum class ShaderDataType
 	{
 		None = 0,
-		Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+		Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool,
+		Half, Half2, Short4, UByte4, UShort
 	};
 
 	static int ShaderDataTypeSize(ShaderDataType type)
@@ -27,12 +28,35 @@ namespace Cardia
 			case ShaderDataType::Int3:	return 4 * 3;
 			case ShaderDataType::Int4:	return 4 * 4;
 			case ShaderDataType::Bool:	return 1;
+			case ShaderDataType::Half:	return 2;
+			case ShaderDataType::Half2:	return 2 * 2;
+			case ShaderDataType::Short4:	return 2 * 4;
+			case ShaderDataType::UByte4:	return 4;
+			case ShaderDataType::UShort:	return 2;
 			default:
 				cdCoreAssert(false, "Unknown ShaderDataType.");
 				return 0;
 		}
 	}
 
+	// Integer types reach the shader as integers unless normalized
+	static bool ShaderDataTypeIsInteger(ShaderDataType type)
+	{
+		switch (type)
+		{
+			case ShaderDataType::Int:
+			case ShaderDataType::Int2:
+			case ShaderDataType::Int3:
+			case ShaderDataType::Int4:
+			case ShaderDataType::Short4:
+			case ShaderDataType::UByte4:
+			case ShaderDataType::UShort:
+				return true;
+			default:
+				return false;
+		}
+	}
+
 	struct BufferElement
 	{
 		ShaderDataType type {};
@@ -43,7 +67,7 @@ namespace Cardia
 
 		BufferElement() = default;
 		BufferElement(ShaderDataType _type, std::string name, bool normalized = false)
-			: type(_type), name(std::move(name)), offset(0), size(ShaderDataTypeSize(type)), normalized(false) {}
+			: type(_type), name(std::move(name)), offset(0), size(ShaderDataTypeSize(type)), normalized(normalized) {}
 
 		int getElementCount() const
 		{
@@ -60,6 +84,11 @@ namespace Cardia
 				case ShaderDataType::Int3:	return 3;
 				case ShaderDataType::Int4:	return 4;
 				case ShaderDataType::Bool:	return 1;
+				case ShaderDataType::Half:	return 1;
+				case ShaderDataType::Half2:	return 2;
+				case ShaderDataType::Short4:	return 4;
+				case ShaderDataType::UByte4:	return 4;
+				case ShaderDataType::UShort:	return 1;
 				default:
 					cdCoreAssert(false, "Unknown ShaderDataType.");
 					return 0;
@@ -99,6 +128,12 @@ namespace Cardia
 		int m_Stride{};
 	};
 
+	// Layout of Vertex or PackedVertex, attribute locations are the same for both formats
+	BufferLayout GetVertexLayout(VertexFormat format);
+
+	// Number of frame regions a streaming buffer cycles through before reusing memory
+	constexpr uint32_t streamingBufferRegions = 3;
+
 	class VertexBuffer
 	{
 	public:
@@ -108,10 +143,22 @@ namespace Cardia
 		virtual void setLayout(const BufferLayout& layout) = 0;
 		virtual const BufferLayout& getLayout() const = 0;
 
-		virtual void setData(const void* data, uint32_t size) = 0;
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		// Exposes the whole buffer to shaders as a storage buffer
+		virtual void bindStorage(int index) const = 0;
+
+		// Streaming buffers only: returns a write pointer into persistently mapped memory,
+		// offset receives the byte offset of that pointer from the start of the buffer.
+		virtual bool isStreaming() const = 0;
+		virtual void* map(uint32_t size, uint32_t alignment, uint32_t& offset) = 0;
+		// Everything mapped so far is read by commands already issued, its regions can be reused once the GPU is done.
+		// Mapping must never wrap around onto a region written since the last fence
+		virtual void fence() = 0;
+		virtual void nextFrame() = 0;
 
 		static std::unique_ptr<VertexBuffer> create(uint32_t size);
-		static std::unique_ptr<VertexBuffer> create(Vertex* vertices, uint32_t size);
+		static std::unique_ptr<VertexBuffer> create(const void* vertices, uint32_t size);
+		static std::unique_ptr<VertexBuffer> createStreaming(uint32_t regionSize);
 	};
 
 	class IndexBuffer
@@ -122,9 +169,18 @@ namespace Cardia
 		virtual void unbind() const = 0;
 		virtual int getCount() const = 0;
 
-		virtual void setData(const void* data, uint32_t size) = 0;
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		virtual bool isStreaming() const = 0;
+		virtual void* map(uint32_t size, uint32_t alignment, uint32_t& offset) = 0;
+		// Everything mapped so far is read by commands already issued, its regions can be reused once the GPU is done.
+		// Mapping must never wrap around onto a region written since the last fence
+		virtual void fence() = 0;
+		virtual void nextFrame() = 0;
+
 		static std::unique_ptr<IndexBuffer> create(uint32_t count);
 		static std::unique_ptr<IndexBuffer> create(uint32_t* indices, uint32_t count);
+		static std::unique_ptr<IndexBuffer> createStreaming(uint32_t indexCount); // Indices per region
 	};
 
 	class StorageBuffer
@@ -133,10 +189,44 @@ namespace Cardia
 		virtual ~StorageBuffer() = default;
 		virtual void bind(int index) const = 0;
 		virtual void unbind() const = 0;
-		virtual void setData(const void* data, uint32_t size) = 0;
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
 
 		static std::unique_ptr<StorageBuffer> create(uint32_t size);
 		static std::unique_ptr<StorageBuffer> create(void* data, uint32_t size);
 	};
 
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() = default;
+		virtual void bind(int index) const = 0;
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		static std::unique_ptr<UniformBuffer> create(uint32_t size);
+	};
+
+	// Layout expected by indirect indexed draws
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance;
+	};
+
+	class IndirectBuffer
+	{
+	public:
+		virtual ~IndirectBuffer() = default;
+		virtual void bind() const = 0;
+		virtual void unbind() const = 0;
+		// Lets compute shaders write the commands, or the draw counts of an indirect count draw
+		virtual void bindStorage(int index) const = 0;
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		virtual uint32_t getSize() const = 0;
+
+		static std::unique_ptr<IndirectBuffer> create(uint32_t size);
+	};
+
 }
\ No newline at end of file
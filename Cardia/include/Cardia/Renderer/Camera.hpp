@@ -23,9 +23,15 @@ namespace Cardia {
 			m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
 			return m_ViewProjectionMatrix;
 		}
+
+		// Opaque draws are sorted front to back and laid in the depth buffer by a depth-only pass first,
+		// shading then only runs for visible fragments. Worth it when fill-rate bound.
+		void setDepthPrePass(bool state) { m_DepthPrePass = state; }
+		bool isDepthPrePass() const { return m_DepthPrePass; }
 	protected:
 		glm::mat4 m_ProjectionMatrix = glm::mat4(1.0f);
 		glm::mat4 m_ViewMatrix {};
 		glm::mat4 m_ViewProjectionMatrix {};
+		bool m_DepthPrePass = false;
 	};
 }
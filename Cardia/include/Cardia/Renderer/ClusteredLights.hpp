@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Buffer.hpp"
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+
+namespace Cardia
+{
+	// Cluster grid, must match basic.frag
+	constexpr uint32_t clusterGridX = 16;
+	constexpr uint32_t clusterGridY = 9;
+	constexpr uint32_t clusterGridZ = 24;
+	constexpr uint32_t clusterCount = clusterGridX * clusterGridY * clusterGridZ;
+	constexpr uint32_t maxLightsPerCluster = 128;
+
+	// std430 layout of the light storage buffer
+	struct LightData
+	{
+		glm::vec4 positionAndType {}; // w: Component::LightType
+		glm::vec4 directionAndRange {};
+		glm::vec4 colorAndCutOff {};
+	};
+
+	// Forward+ light culling: point and spot lights are binned on the CPU into view space clusters
+	// (screen tiles times depth slices), fragments only walk the lights of their own cluster.
+	// Buffers persist between frames and only grow.
+	class ClusteredLights
+	{
+	public:
+		ClusteredLights();
+
+		// Directional lights are moved first, they light every fragment
+		void update(const std::vector<LightData>& lights, const glm::mat4& view, const glm::mat4& projection);
+		// Lights at 0, clusters at 6, light indices at 7
+		void bind() const;
+
+		uint32_t getLightCount() const { return static_cast<uint32_t>(m_Lights.size()); }
+		uint32_t getDirectionalLightCount() const { return m_DirectionalLightCount; }
+		// x: scale, y: bias, z: 1 when slices are logarithmic, slice = depth * scale - bias
+		const glm::vec4& getDepthParameters() const { return m_DepthParameters; }
+
+	private:
+		struct ClusterRange
+		{
+			glm::uvec3 min;
+			glm::uvec3 max;
+		};
+
+		uint32_t depthSlice(float viewDepth) const;
+		bool clusterRange(const LightData& light, const glm::mat4& view, const glm::mat4& projection, ClusterRange& range) const;
+
+		std::vector<LightData> m_Lights;
+		std::vector<ClusterRange> m_Ranges;
+		std::vector<glm::uvec2> m_Clusters; // offset, count into m_LightIndices
+		std::vector<uint32_t> m_ClusterSizes; // Capped light count of each cluster
+		std::vector<uint32_t> m_LightIndices;
+		uint32_t m_DirectionalLightCount {};
+		glm::vec4 m_DepthParameters {};
+		float m_Near {};
+		float m_Far {};
+
+		std::unique_ptr<StorageBuffer> m_LightBuffer;
+		uint32_t m_LightCapacity {};
+		std::unique_ptr<StorageBuffer> m_ClusterBuffer;
+		std::unique_ptr<StorageBuffer> m_LightIndexBuffer;
+		uint32_t m_LightIndexCapacity {};
+	};
+}
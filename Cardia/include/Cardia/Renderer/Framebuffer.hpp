@@ -44,6 +44,15 @@ namespace Cardia
 		uint32_t samples = 1;
 	};
 
+	// Rectangle of framebuffer pixels, the origin is the bottom left corner
+	struct PixelRegion
+	{
+		int x = 0;
+		int y = 0;
+		int width = 1;
+		int height = 1;
+	};
+
 	class Framebuffer
 	{
 	public:
@@ -53,10 +62,19 @@ namespace Cardia
 
 		virtual void Resize(int width, int height) = 0;
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
+		// Asynchronous ReadPixel of an integer attachment.
+		// The region is copied on the GPU, PollPixels hands it back a frame or two later.
+		virtual void RequestPixels(uint32_t attachmentIndex, const PixelRegion& region) = 0;
+		// Oldest requested region the GPU is done with, never waits. Rows go from the bottom up
+		virtual bool PollPixels(PixelRegion& region, std::vector<int>& pixels) = 0;
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
 
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
+		virtual const FramebufferSpec& GetSpecification() const = 0;
+		// Attachments can be larger than the framebuffer, only their bottom left width x height pixels are drawn
+		virtual int GetAttachmentWidth() const = 0;
+		virtual int GetAttachmentHeight() const = 0;
 
 		static std::unique_ptr<Framebuffer> create(const FramebufferSpec& spec);
 
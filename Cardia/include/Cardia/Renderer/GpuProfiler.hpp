@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Cardia/Core/Core.hpp"
+
+#include <array>
+#include <memory>
+
+
+namespace Cardia
+{
+	// Passes timed on the GPU every frame
+	enum class GpuPass
+	{
+		LightsUpload = 0,
+		Sprites,
+		Meshes,
+		ImGui,
+		Count
+	};
+
+	constexpr size_t gpuPassCount = static_cast<size_t>(GpuPass::Count);
+
+	// GPU time of each pass, measured with timestamp queries read back frames later so the CPU never waits on them
+	class GpuProfiler
+	{
+	public:
+		virtual ~GpuProfiler() = default;
+
+		// Called by whoever owns the context, a pass is timed once per frame
+		virtual void begin(GpuPass pass) = 0;
+		virtual void end(GpuPass pass) = 0;
+		// Closes the frame and collects the oldest one if the GPU is done with it
+		virtual void nextFrame() = 0;
+
+		// Milliseconds of the latest collected frame, zero for a pass it did not run
+		float getMilliseconds(GpuPass pass) const { return m_Milliseconds[static_cast<size_t>(pass)]; }
+
+		static void init();
+		static void quit();
+		static GpuProfiler& get() { cdCoreAssert(s_Instance.get(), "GpuProfiler not initialized."); return *s_Instance; }
+
+	protected:
+		std::array<float, gpuPassCount> m_Milliseconds {};
+
+	private:
+		static inline std::unique_ptr<GpuProfiler> s_Instance = nullptr;
+	};
+}
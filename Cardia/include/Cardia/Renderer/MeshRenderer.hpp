@@ -12,11 +12,14 @@ namespace Cardia
 	public:
 		MeshRenderer() = default;
 
-		void SubmitMesh(std::shared_ptr<Mesh> mesh);
+		void SubmitMesh(std::shared_ptr<Mesh> mesh, VertexFormat format = VertexFormat::Standard);
 		std::shared_ptr<Mesh> GetMesh() { return m_Mesh; }
-		void Draw();
+		VertexFormat GetVertexFormat() const { return m_VertexFormat; }
+		// Records every sub-mesh into StaticMeshPool, back end only
+		void Submit(const glm::mat4& model, int32_t entityID) const;
 	private:
 		std::vector<SubMeshRenderer> m_SubMeshRenderers {};
 		std::shared_ptr<Mesh> m_Mesh;
+		VertexFormat m_VertexFormat = VertexFormat::Standard;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Cardia/Renderer/Buffer.hpp"
+
+#include <array>
+
+
+namespace Cardia
+{
+	// CPU memory standing for a persistently mapped buffer, cycled through the same regions.
+	// There is nothing to wait for, wrapping onto unfenced regions is still caught like on a real backend
+	class NullStreamingRing
+	{
+	public:
+		void create(uint32_t regionSize);
+		void* map(uint32_t size, uint32_t alignment, uint32_t& offset);
+		void fence();
+		void nextFrame();
+
+	private:
+		void advance();
+
+		std::vector<uint8_t> m_Data;
+		uint32_t m_RegionSize {};
+		uint32_t m_Region {};
+		uint32_t m_Cursor {};
+		std::array<bool, streamingBufferRegions> m_Unfenced {}; // Written since the last fence
+	};
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		explicit NullVertexBuffer(uint32_t size, bool streaming = false);
+		NullVertexBuffer(const void* vertices, uint32_t size);
+		void bind() const override;
+		void unbind() const override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+		void bindStorage(int index) const override;
+		void setLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		const BufferLayout& getLayout() const override { return m_Layout; }
+
+		bool isStreaming() const override { return m_Streaming; }
+		void* map(uint32_t size, uint32_t alignment, uint32_t& offset) override;
+		void fence() override;
+		void nextFrame() override;
+
+	private:
+		BufferLayout m_Layout;
+		bool m_Streaming = false;
+		NullStreamingRing m_Ring;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		explicit NullIndexBuffer(uint32_t count, bool streaming = false);
+		NullIndexBuffer(const uint32_t* indices, uint32_t count);
+		void bind() const override;
+		void unbind() const override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+		inline int getCount() const override { return m_Count; }
+
+		bool isStreaming() const override { return m_Streaming; }
+		void* map(uint32_t size, uint32_t alignment, uint32_t& offset) override;
+		void fence() override;
+		void nextFrame() override;
+
+	private:
+		uint32_t m_Count {};
+		bool m_Streaming = false;
+		NullStreamingRing m_Ring;
+	};
+
+	class NullStorageBuffer : public StorageBuffer
+	{
+	public:
+		explicit NullStorageBuffer(uint32_t size);
+		NullStorageBuffer(const void* data, uint32_t size);
+		void bind(int index) const override;
+		void unbind() const override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+	};
+
+	class NullUniformBuffer : public UniformBuffer
+	{
+	public:
+		explicit NullUniformBuffer(uint32_t size);
+		void bind(int index) const override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+	};
+
+	class NullIndirectBuffer : public IndirectBuffer
+	{
+	public:
+		explicit NullIndirectBuffer(uint32_t size);
+		void bind() const override;
+		void unbind() const override;
+		void bindStorage(int index) const override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+		uint32_t getSize() const override { return m_Size; }
+
+	private:
+		uint32_t m_Size {};
+	};
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Cardia/Renderer/RendererContext.hpp"
+
+
+namespace Cardia
+{
+	// No context to create or bind, the render thread runs all the same
+	class NullContext : public RendererContext
+	{
+	public:
+		void init() override {}
+		void swapBuffers() override {}
+		void makeCurrent() override {}
+		void releaseCurrent() override {}
+	};
+}
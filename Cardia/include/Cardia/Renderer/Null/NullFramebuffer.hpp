@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Cardia/Renderer/Framebuffer.hpp"
+
+#include <deque>
+
+
+namespace Cardia
+{
+	// Integer attachments read back as -1, the value they are cleared to for picking
+	class NullFramebuffer : public Framebuffer
+	{
+	public:
+		explicit NullFramebuffer(FramebufferSpec spec);
+		void Bind() const override;
+		void Unbind() const override;
+
+		void Resize(int width, int height) override;
+		int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+		void RequestPixels(uint32_t attachmentIndex, const PixelRegion& region) override;
+		bool PollPixels(PixelRegion& region, std::vector<int>& pixels) override;
+
+		void ClearAttachment(uint32_t attachmentIndex, int value) override;
+
+		uint32_t GetColorAttachmentRendererID(uint32_t index) const override { return m_ColorAttachments[index]; }
+		const FramebufferSpec& GetSpecification() const override { return m_Spec; }
+		int GetAttachmentWidth() const override { return m_Spec.width; }
+		int GetAttachmentHeight() const override { return m_Spec.height; }
+
+	private:
+		FramebufferSpec m_Spec;
+		std::vector<uint32_t> m_ColorAttachments;
+		std::deque<PixelRegion> m_PendingReads;
+	};
+}
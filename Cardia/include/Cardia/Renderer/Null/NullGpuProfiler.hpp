@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Cardia/Renderer/GpuProfiler.hpp"
+
+
+namespace Cardia
+{
+	// Nothing runs on a GPU, every pass takes zero milliseconds
+	class NullGpuProfiler : public GpuProfiler
+	{
+	public:
+		void begin(GpuPass pass) override {}
+		void end(GpuPass pass) override {}
+		void nextFrame() override {}
+	};
+}
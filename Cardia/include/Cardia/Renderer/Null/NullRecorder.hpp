@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace Cardia
+{
+	// What the null backend was asked to do since the last reset
+	struct NullRenderCounters
+	{
+		uint64_t calls = 0; // Every call reaching the backend, creations included
+		uint64_t drawCalls = 0;
+		uint64_t dispatches = 0;
+		uint64_t uploadedBytes = 0; // Buffer writes, streaming maps and texture data
+	};
+
+	// Counters of the null backend, updated from the front end and the render thread alike
+	class NullRecorder
+	{
+	public:
+		static void call();
+		static void draw();
+		static void dispatch();
+		static void upload(uint64_t bytes);
+		// Counted as a call, ids start at 1 like GL names
+		static uint32_t createObject();
+
+		static NullRenderCounters getCounters();
+		static void resetCounters();
+	};
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Cardia/Renderer/RenderAPI.hpp"
+
+
+namespace Cardia
+{
+	// Renders nothing, every call is only counted by NullRecorder
+	class NullRenderAPI : public RenderAPI
+	{
+	public:
+		void setClearColor(const glm::vec4& color) override;
+		void clear() override;
+		void setViewPort(int x, int y, int w, int h) override;
+		void setWireFrame(bool state) override;
+		void clearDepthBuffer() override;
+		std::string getVendor() override { return "Cardia"; }
+		std::string getRenderer() override { return "Null"; }
+		std::string getVersion() override { return "0.0"; }
+		int getMaxTextureSlots() override;
+		void enableDepth() override;
+		void disableDepth() override;
+		void enableBlending() override;
+		void disableBlending() override;
+		void setDepthFunction(DepthFunction function) override;
+		void setDepthWrite(bool state) override;
+		void setColorWrite(bool state) override;
+
+		StateCounters getStateCounters() override;
+		void resetStateCounters() override;
+		void invalidateStateCache() override {}
+
+		void drawIndexed(const VertexArray* vertexArray, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) override;
+		void drawIndexedInstanced(const VertexArray* vertexArray, uint32_t instanceCount, uint32_t baseInstance) override;
+		void multiDrawIndexedIndirect(const VertexArray* vertexArray, const IndirectBuffer& commands, uint32_t drawCount, uint32_t firstCommand) override;
+		void multiDrawIndexedIndirectCount(const VertexArray* vertexArray, const IndirectBuffer& commands, const IndirectBuffer& drawCounts, uint32_t countIndex, uint32_t maxDrawCount, uint32_t firstCommand) override;
+
+		void dispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		void computeBarrier() override;
+
+	private:
+		uint32_t m_StateChanges = 0;
+	};
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Cardia/Renderer/RenderGraph.hpp"
+
+#include <deque>
+
+
+namespace Cardia
+{
+	// Textures are only names, reads hand back regions filled with -1
+	class NullRenderGraphBackend : public RenderGraphBackend
+	{
+	public:
+		uint32_t acquireTexture(const RenderGraphTextureDesc& desc) override;
+		void releaseTexture(const RenderGraphTextureDesc& desc, uint32_t texture) override {}
+		void clearTexture(uint32_t texture, const RenderGraphTextureDesc& desc) override;
+
+		void beginPass(const std::vector<uint32_t>& colors, uint32_t depth, int width, int height) override;
+		void endPass() override;
+		void barrier(RenderGraphAccess access) override;
+
+		void requestPixels(uint32_t texture, const PixelRegion& region) override;
+		bool pollPixels(PixelRegion& region, std::vector<int>& pixels) override;
+
+	private:
+		std::deque<PixelRegion> m_PendingReads;
+	};
+}
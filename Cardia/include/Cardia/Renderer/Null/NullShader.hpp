@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Cardia/Renderer/Shader.hpp"
+
+
+namespace Cardia
+{
+	// Sources are never read, uniforms are only counted
+	class NullShader : public Shader
+	{
+	public:
+		NullShader();
+		void bind() const override;
+		void unbind() const override;
+
+		void setFloat4(const std::string& name, const glm::vec4& value) override;
+		void setFloat4Array(const std::string& name, const glm::vec4* values, int count) override;
+		void setFloat3(const std::string& name, const glm::vec3& value) override;
+		void setMat4(const std::string& name, const glm::mat4& value) override;
+		void setInt(const std::string& name, int value) override;
+		void setIntArray(const std::string& name, int* values, int count) override;
+	};
+}
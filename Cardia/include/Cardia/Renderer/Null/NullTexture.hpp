@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Cardia/Renderer/Texture.hpp"
+
+
+namespace Cardia
+{
+	// Only the header of image files is read, the size of their pixels is counted as uploaded.
+	// Containers are read whole, their stored levels are what the GPU would receive
+	class NullTexture2D : public Texture2D
+	{
+	public:
+		explicit NullTexture2D(std::string path);
+		explicit NullTexture2D(int width, int height, void* data);
+
+		inline uint32_t getWidth() const override { return m_Width; }
+		inline uint32_t getHeight() const override { return m_Height; }
+
+		inline bool operator==(const Texture& other) const override {
+			return m_TextureID == ((NullTexture2D&)other).m_TextureID;
+		}
+
+		void bind(int slot) const override;
+		uint32_t getRendererID() override { return m_TextureID; }
+
+	private:
+		int32_t m_Width{}, m_Height{};
+		uint32_t m_TextureID;
+	};
+}
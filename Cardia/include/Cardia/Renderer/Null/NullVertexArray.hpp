@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Cardia/Renderer/VertexArray.hpp"
+
+
+namespace Cardia
+{
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray();
+		void bind() const override;
+		void unbind() const override;
+		void setVertexBuffer (std::unique_ptr<VertexBuffer> vertexBuffer) override;
+		void setIndexBuffer (std::unique_ptr<IndexBuffer> indexBuffer) override;
+		void setInstanceBuffer (std::unique_ptr<VertexBuffer> instanceBuffer) override;
+		VertexBuffer& getVertexBuffer() override { return *m_VertexBuffer; }
+		IndexBuffer& getIndexBuffer () const override { return *m_IndexBuffer; }
+		VertexBuffer& getInstanceBuffer() override { return *m_InstanceBuffer; }
+
+	private:
+		std::unique_ptr<VertexBuffer> m_VertexBuffer;
+		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+	};
+}
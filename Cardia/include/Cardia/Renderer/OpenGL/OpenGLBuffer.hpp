@@ -2,40 +2,82 @@
 
 #include "Cardia/Renderer/Buffer.hpp"
 
+#include <array>
+
 
 namespace Cardia
 {
+	// Persistently mapped buffer storage split in streamingBufferRegions regions.
+	// Each region is guarded by a fence so the CPU never writes memory the GPU may still read,
+	// a region is only fenced once the commands reading what was written to it are issued.
+	class OpenGLPersistentRing
+	{
+	public:
+		void create(uint32_t bufferID, uint32_t regionSize);
+		void destroy();
+		void* map(uint32_t size, uint32_t alignment, uint32_t& offset);
+		void fence();
+		void nextFrame();
+
+	private:
+		// Moves on to the next region once the GPU is done with it
+		void advance();
+		void waitRegion(uint32_t region);
+
+		uint8_t* m_MappedData = nullptr;
+		uint32_t m_RegionSize {};
+		uint32_t m_Region {};
+		uint32_t m_Cursor {};
+		std::array<bool, streamingBufferRegions> m_Unfenced {}; // Written since the last fence
+		std::array<void*, streamingBufferRegions> m_Fences {};
+	};
+
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
 	public:
-		OpenGLVertexBuffer(Vertex* vertices, uint32_t size);
-		OpenGLVertexBuffer(uint32_t size);
+		OpenGLVertexBuffer(const void* vertices, uint32_t size);
+		explicit OpenGLVertexBuffer(uint32_t size, bool streaming = false);
 		~OpenGLVertexBuffer() override;
 		void bind() const override;
 		void unbind() const override;
-		void setData(const void* data, uint32_t size) override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+		void bindStorage(int index) const override;
 		void setLayout(const BufferLayout& layout) override { m_Layout = layout; }
 		const BufferLayout& getLayout() const override { return m_Layout; }
 
+		bool isStreaming() const override { return m_Streaming; }
+		void* map(uint32_t size, uint32_t alignment, uint32_t& offset) override;
+		void fence() override;
+		void nextFrame() override;
+
 	private:
 		uint32_t m_VertexBufferID {};
 		BufferLayout m_Layout;
+		bool m_Streaming = false;
+		OpenGLPersistentRing m_Ring;
 	};
 
 	class OpenGLIndexBuffer : public IndexBuffer
 	{
 	public:
 		OpenGLIndexBuffer(uint32_t* indices, uint32_t count);
-		explicit OpenGLIndexBuffer(uint32_t count);
+		explicit OpenGLIndexBuffer(uint32_t count, bool streaming = false);
 		~OpenGLIndexBuffer() override;
 		void bind() const override;
 		void unbind() const override;
-		void setData(const void* data, uint32_t size) override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
 		inline int getCount() const override { return m_Count; }
 
+		bool isStreaming() const override { return m_Streaming; }
+		void* map(uint32_t size, uint32_t alignment, uint32_t& offset) override;
+		void fence() override;
+		void nextFrame() override;
+
 	private:
 		uint32_t m_IndexBufferID {};
 		uint32_t m_Count {};
+		bool m_Streaming = false;
+		OpenGLPersistentRing m_Ring;
 	};
 
 	class OpenGLStorageBuffer : public StorageBuffer
@@ -46,9 +88,39 @@ namespace Cardia
 		~OpenGLStorageBuffer() override;
 		void bind(int index) const override;
 		void unbind() const override;
-		void setData(const void* data, uint32_t size) override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
 
 	private:
 		uint32_t m_StorageBufferID {};
 	};
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		explicit OpenGLUniformBuffer(uint32_t size);
+		~OpenGLUniformBuffer() override;
+		void bind(int index) const override;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+
+	private:
+		uint32_t m_UniformBufferID {};
+	};
+
+	class OpenGLIndirectBuffer : public IndirectBuffer
+	{
+	public:
+		explicit OpenGLIndirectBuffer(uint32_t size);
+		~OpenGLIndirectBuffer() override;
+		void bind() const override;
+		void unbind() const override;
+		void bindStorage(int index) const override;
+		// Source of the draw count for multiDrawIndexedIndirectCount
+		void bindParameter() const;
+		void setData(const void* data, uint32_t size, uint32_t offset) override;
+		uint32_t getSize() const override { return m_Size; }
+
+	private:
+		uint32_t m_IndirectBufferID {};
+		uint32_t m_Size {};
+	};
 }
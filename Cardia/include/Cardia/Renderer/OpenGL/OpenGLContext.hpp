@@ -13,6 +13,12 @@ namespace Cardia {
 
 		void init() override;
 		void swapBuffers() override;
+		void makeCurrent() override;
+		void releaseCurrent() override;
+
+		using ProcLoader = void* (*)(const char* name);
+		// Loads GL functions through loader and sets the default state, the context must be current
+		static void loadGL(ProcLoader loader);
 
 	private:
 		GLFWwindow* m_Window;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Cardia/Renderer/Framebuffer.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLPixelReader.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLRenderTargetPool.hpp"
 
 
 namespace Cardia
@@ -16,13 +18,20 @@ namespace Cardia
 
 		void Resize(int width, int height) override;
 		int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+		void RequestPixels(uint32_t attachmentIndex, const PixelRegion& region) override;
+		bool PollPixels(PixelRegion& region, std::vector<int>& pixels) override;
 
 		void ClearAttachment(uint32_t attachmentIndex, int value) override;
 
 		inline uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { return m_ColorAttachments[index]; }
+		inline const FramebufferSpec& GetSpecification() const override { return m_Spec; }
+		inline int GetAttachmentWidth() const override { return m_AttachmentWidth; }
+		inline int GetAttachmentHeight() const override { return m_AttachmentHeight; }
 
 	private:
-		void GenerateFramebuffer();
+		void GenerateFramebuffer(int attachmentWidth, int attachmentHeight);
+		void ReleaseAttachments();
+		OpenGLRenderTargetPool::Key AttachmentKey(FramebufferTextureFormat format) const;
 
 	private:
 		uint32_t m_FramebufferID {};
@@ -33,5 +42,9 @@ namespace Cardia
 
 		std::vector<uint32_t> m_ColorAttachments;
 		uint32_t m_DepthAttachment = 0;
+		int m_AttachmentWidth = 0; // Bucketed, at least the framebuffer size
+		int m_AttachmentHeight = 0;
+
+		OpenGLPixelReader m_PixelReader;
  	};
 }
\ No newline at end of file
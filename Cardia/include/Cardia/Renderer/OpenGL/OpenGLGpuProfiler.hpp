@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Cardia/Renderer/GpuProfiler.hpp"
+
+
+namespace Cardia
+{
+	// Frames in flight of the queries: one is recorded while the GPU finishes the other
+	constexpr uint32_t gpuProfilerFrames = 2;
+
+	class OpenGLGpuProfiler : public GpuProfiler
+	{
+	public:
+		OpenGLGpuProfiler();
+		~OpenGLGpuProfiler() override;
+
+		void begin(GpuPass pass) override;
+		void end(GpuPass pass) override;
+		void nextFrame() override;
+
+	private:
+		struct FrameQueries
+		{
+			std::array<uint32_t, gpuPassCount * 2> timestamps {}; // Begin and end of each pass
+			std::array<bool, gpuPassCount> recorded {};
+			bool pending = false; // Waiting for its results
+		};
+
+		bool collect(FrameQueries& frame);
+
+		std::array<FrameQueries, gpuProfilerFrames> m_Frames {};
+		uint32_t m_CurrentFrame = 0;
+		bool m_Recording = true; // False while the current slot still waits for its previous results
+	};
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Cardia/Renderer/RendererContext.hpp"
+
+
+namespace Cardia
+{
+	// Context without any window or display server, through EGL. On a machine without a GPU, Mesa renders it with llvmpipe.
+	// There is no default framebuffer, everything has to be drawn into a Framebuffer.
+	class OpenGLHeadlessContext : public RendererContext
+	{
+	public:
+		OpenGLHeadlessContext() = default;
+		~OpenGLHeadlessContext() override;
+
+		void init() override;
+		void swapBuffers() override;
+		void makeCurrent() override;
+		void releaseCurrent() override;
+
+	private:
+		void* m_Display = nullptr; // EGLDisplay
+		void* m_Context = nullptr; // EGLContext
+	};
+}
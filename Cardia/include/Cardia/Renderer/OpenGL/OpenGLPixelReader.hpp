@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Cardia/Renderer/Framebuffer.hpp"
+
+#include <deque>
+
+
+namespace Cardia
+{
+	// Asynchronous copies of integer texture regions through pixel-pack buffers, handed back once the GPU is done
+	class OpenGLPixelReader
+	{
+	public:
+		OpenGLPixelReader() = default;
+		~OpenGLPixelReader();
+		OpenGLPixelReader(const OpenGLPixelReader&) = delete;
+		OpenGLPixelReader& operator=(const OpenGLPixelReader&) = delete;
+
+		void request(uint32_t texture, const PixelRegion& region);
+		// Oldest requested region the GPU is done with, never waits
+		bool poll(PixelRegion& region, std::vector<int>& pixels);
+
+	private:
+		// Pixel-pack buffer receiving one requested region
+		struct PixelReadback
+		{
+			uint32_t buffer = 0;
+			uint32_t capacity = 0; // In bytes
+			PixelRegion region;
+			void* fence = nullptr; // GLsync, signaled once the copy is done
+		};
+
+		std::deque<PixelReadback> m_PendingReadbacks; // Oldest first, fences are signaled in that order
+		std::vector<PixelReadback> m_FreeReadbacks; // Buffers kept for the next requests
+	};
+}
@@ -16,10 +16,29 @@ namespace Cardia
 		std::string getVendor() override;
 		std::string getRenderer() override;
 		std::string getVersion() override;
+		int getMaxTextureSlots() override;
 		void enableDepth() override;
 		void disableDepth() override;
+		void enableBlending() override;
+		void disableBlending() override;
+		void setDepthFunction(DepthFunction function) override;
+		void setDepthWrite(bool state) override;
+		void setColorWrite(bool state) override;
 
-		void drawIndexed(const VertexArray* vertexArray, uint32_t indexCount) override;
+		StateCounters getStateCounters() override;
+		void resetStateCounters() override;
+		void invalidateStateCache() override;
+
+		void drawIndexed(const VertexArray* vertexArray, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) override;
+		void drawIndexedInstanced(const VertexArray* vertexArray, uint32_t instanceCount, uint32_t baseInstance) override;
+		void multiDrawIndexedIndirect(const VertexArray* vertexArray, const IndirectBuffer& commands, uint32_t drawCount, uint32_t firstCommand) override;
+		void multiDrawIndexedIndirectCount(const VertexArray* vertexArray, const IndirectBuffer& commands, const IndirectBuffer& drawCounts, uint32_t countIndex, uint32_t maxDrawCount, uint32_t firstCommand) override;
+
+		void dispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		void computeBarrier() override;
+
+	private:
+		int m_MaxTextureSlots = 0; // Queried once, batches are created on the front end thread
 	};
 }
 
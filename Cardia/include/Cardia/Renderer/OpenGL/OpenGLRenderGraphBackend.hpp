@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Cardia/Renderer/RenderGraph.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLPixelReader.hpp"
+
+
+namespace Cardia
+{
+	// Passes render through a single framebuffer object, its attachments are swapped for each pass.
+	// Textures come from OpenGLRenderTargetPool and go back to it at the end of the frame.
+	class OpenGLRenderGraphBackend : public RenderGraphBackend
+	{
+	public:
+		OpenGLRenderGraphBackend() = default;
+		~OpenGLRenderGraphBackend() override;
+
+		uint32_t acquireTexture(const RenderGraphTextureDesc& desc) override;
+		void releaseTexture(const RenderGraphTextureDesc& desc, uint32_t texture) override;
+		void clearTexture(uint32_t texture, const RenderGraphTextureDesc& desc) override;
+
+		void beginPass(const std::vector<uint32_t>& colors, uint32_t depth, int width, int height) override;
+		void endPass() override;
+		void barrier(RenderGraphAccess access) override;
+
+		void requestPixels(uint32_t texture, const PixelRegion& region) override;
+		bool pollPixels(PixelRegion& region, std::vector<int>& pixels) override;
+
+	private:
+		uint32_t m_Framebuffer = 0; // Created on the first pass, on whichever thread replays it
+		uint32_t m_AttachedColors = 0;
+		OpenGLPixelReader m_PixelReader;
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Cardia/Renderer/Framebuffer.hpp"
+
+#include <cstdint>
+
+
+namespace Cardia
+{
+	// Attachment sizes are rounded up to this many pixels, nearby sizes share the same textures
+	constexpr int renderTargetBucket = 128;
+
+	inline int RenderTargetBucketSize(int size)
+	{
+		return (size + renderTargetBucket - 1) / renderTargetBucket * renderTargetBucket;
+	}
+
+	// Sized internal format of an attachment, GL_NONE for None
+	uint32_t RenderTargetInternalFormat(FramebufferTextureFormat format);
+
+	// Textures backing framebuffer attachments. A released texture is kept for the next attachment
+	// of the same format, bucketed size and sample count instead of being deleted.
+	class OpenGLRenderTargetPool
+	{
+	public:
+		struct Key
+		{
+			uint32_t internalFormat;
+			int width; // Bucketed
+			int height;
+			uint32_t samples;
+
+			bool operator==(const Key& other) const = default;
+		};
+
+		static uint32_t acquire(const Key& key);
+		static void release(const Key& key, uint32_t texture);
+	};
+}
@@ -2,7 +2,8 @@
 
 #include "Cardia/Renderer/Shader.hpp"
 
-#include <initializer_list>
+#include <filesystem>
+#include <unordered_map>
 
 
 namespace Cardia
@@ -10,11 +11,16 @@ namespace Cardia
 	class OpenGLShader : public Shader
 	{
 	public:
-		OpenGLShader(std::initializer_list<std::string> filePaths);
+		OpenGLShader(const std::vector<std::string>& filePaths, ShaderFeatures features = ShaderFeature::None);
 		void bind() const override;
 		void unbind() const override;
+		bool isReady() const override;
+
+		// Set by OpenGLContext once the driver compiles on its own threads and reports GL_COMPLETION_STATUS_KHR
+		static void setCompletionStatusQuery(bool state);
 
 		void setFloat4(const std::string& name, const glm::vec4& value) override;
+		void setFloat4Array(const std::string& name, const glm::vec4* values, int count) override;
 		void setFloat3(const std::string& name, const glm::vec3& value) override;
 		void setMat4(const std::string& name, const glm::mat4& value) override;
 		void setInt(const std::string& name, int value) override;
@@ -22,10 +28,21 @@ namespace Cardia
 
 		void setUniformMat4(const std::string& name, glm::mat4 matrix) const;
 		void setUniformFloat4(const std::string& name, glm::vec4 data) const;
+		void setUniformFloat4Array(const std::string& name, const glm::vec4* values, int count) const;
 		void setUniformFloat3(const std::string& name, glm::vec3 data) const;
 		void setUniformInt(const std::string& name, int value) const;
 		void setUniformIntArray(const std::string& name, int* values, int count) const;
 	private:
-		uint32_t m_ShaderID;
+		// Compile and link run in the background, errors are reported and the binary cached on first bind
+		void finishLink() const;
+		// Filled once the program is linked, unknown names resolve to -1 which GL ignores.
+		// Element i of every sampler2D array is bound to texture slot i, for the lifetime of the program
+		void reflectUniforms() const;
+		int getUniformLocation(const std::string& name) const;
+
+		mutable uint32_t m_ShaderID;
+		mutable std::vector<uint32_t> m_PendingStages;
+		mutable std::unordered_map<std::string, int> m_UniformLocations;
+		std::filesystem::path m_CachePath; // Empty when the program came from the cache or binaries are unsupported
 	};
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Cardia/Renderer/RenderAPI.hpp"
+
+
+namespace Cardia
+{
+	// Shadow copy of the binding state of the current context, calls that would not change it are skipped.
+	// Only valid for whoever owns the context, invalidate() it when GL state is changed behind its back.
+	class OpenGLStateCache
+	{
+	public:
+		static void useProgram(uint32_t program);
+		static void bindVertexArray(uint32_t vertexArray);
+		static void bindBuffer(uint32_t target, uint32_t buffer);
+		static void bindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+		static void bindTextureUnit(uint32_t unit, uint32_t texture);
+		static void setCapability(uint32_t capability, bool enabled);
+		static void setDepthFunc(uint32_t function);
+		static void setDepthMask(bool enabled);
+		static void setColorMask(bool enabled); // All channels of every draw buffer
+
+		// Deleted names are reused by the driver, they must not stay cached
+		static void forgetBuffer(uint32_t buffer);
+		static void forgetVertexArray(uint32_t vertexArray);
+		static void forgetTexture(uint32_t texture);
+
+		static void invalidate();
+
+		static RenderAPI::StateCounters getCounters();
+		static void resetCounters();
+	};
+}
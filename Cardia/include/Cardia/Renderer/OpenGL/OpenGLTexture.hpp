@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Cardia/Renderer/Texture.hpp"
+#include "Cardia/Renderer/TextureData.hpp"
 
 
 namespace Cardia
@@ -23,6 +24,10 @@ namespace Cardia
 		uint32_t getRendererID() override;
 
 	private:
+		// KTX2 and DDS files, uploaded with the mip chain they store
+		void loadContainer();
+		void createStorage(TextureFormat format, uint32_t levels);
+
 		int32_t m_Width{}, m_Height{};
 		uint32_t m_TextureID;
 	};
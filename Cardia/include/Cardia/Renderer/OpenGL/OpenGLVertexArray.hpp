@@ -14,12 +14,18 @@ namespace Cardia
 		void unbind() const override;
 		void setVertexBuffer (std::unique_ptr<VertexBuffer> vertexBuffer) override;
 		void setIndexBuffer (std::unique_ptr<IndexBuffer> indexBuffer) override;
+		void setInstanceBuffer (std::unique_ptr<VertexBuffer> instanceBuffer) override;
 		virtual VertexBuffer& getVertexBuffer() override;
 		virtual IndexBuffer& getIndexBuffer () const override;
+		virtual VertexBuffer& getInstanceBuffer() override;
 
 	private:
+		uint32_t bindLayout(const VertexBuffer& buffer, uint32_t firstIndex, uint32_t divisor) const;
+
 		uint32_t m_VertexArrayID{};
+		uint32_t m_VertexAttributeCount{};
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
 		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<VertexBuffer> m_InstanceBuffer;
 	};
 }
\ No newline at end of file
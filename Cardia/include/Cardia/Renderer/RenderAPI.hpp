@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VertexArray.hpp"
+#include "Buffer.hpp"
 
 #include <glm/glm.hpp>
 
@@ -17,6 +18,17 @@ namespace Cardia
 			None = 0, OpenGL = 1 //, Vulkan = 2, Direct3D = 3
 		};
 
+		enum class DepthFunction
+		{
+			Less = 0, Equal = 1
+		};
+
+		struct StateCounters
+		{
+			uint32_t issued = 0;
+			uint32_t elided = 0;
+		};
+
 		static void init();
 
 		virtual void setClearColor(const glm::vec4& color) = 0;
@@ -27,12 +39,36 @@ namespace Cardia
 		virtual std::string getVendor() = 0;
 		virtual std::string getRenderer() = 0;
 		virtual std::string getVersion() = 0;
+		virtual int getMaxTextureSlots() = 0;
 		virtual void enableDepth() = 0;
 		virtual void disableDepth() = 0;
+		virtual void enableBlending() = 0;
+		virtual void disableBlending() = 0;
+		virtual void setDepthFunction(DepthFunction function) = 0;
+		virtual void setDepthWrite(bool state) = 0;
+		// Color writes off still update depth, used by depth-only passes
+		virtual void setColorWrite(bool state) = 0;
+
+		// State changes sent to the driver and skipped as redundant since the last reset
+		virtual StateCounters getStateCounters() = 0;
+		virtual void resetStateCounters() = 0;
+		// Forgets tracked state, for code that changes it without going through the renderer (ImGui)
+		virtual void invalidateStateCache() = 0;
+
+		virtual void drawIndexed(const VertexArray* vertexArray, uint32_t indexCount = 0, uint32_t firstIndex = 0, int32_t baseVertex = 0) = 0;
+		virtual void drawIndexedInstanced(const VertexArray* vertexArray, uint32_t instanceCount, uint32_t baseInstance = 0) = 0;
+		// Issues drawCount DrawElementsIndirectCommand read from commands, starting at firstCommand
+		virtual void multiDrawIndexedIndirect(const VertexArray* vertexArray, const IndirectBuffer& commands, uint32_t drawCount, uint32_t firstCommand = 0) = 0;
+		// Same, the actual draw count is the uint32 at countIndex in drawCounts, written on the GPU
+		virtual void multiDrawIndexedIndirectCount(const VertexArray* vertexArray, const IndirectBuffer& commands, const IndirectBuffer& drawCounts, uint32_t countIndex, uint32_t maxDrawCount, uint32_t firstCommand = 0) = 0;
 
-		virtual void drawIndexed(const VertexArray* vertexArray, uint32_t indexCount = 0) = 0;
+		virtual void dispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1) = 0;
+		// Makes compute shader writes visible to following draws, indirect commands included
+		virtual void computeBarrier() = 0;
 
 		static API& getAPI() { return s_API; }
+		// Before the window and the renderer are created, None selects the null backend
+		static void setAPI(API api) { s_API = api; }
 		static RenderAPI& get() { cdCoreAssert(s_Instance.get(), "RenderAPI not initialized."); return *s_Instance; }
 
 	private:
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace Cardia
+{
+	// Records render commands (any callable) into reused memory blocks and replays them in order
+	class RenderCommandQueue
+	{
+	public:
+		RenderCommandQueue() = default;
+		~RenderCommandQueue();
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		template<typename Fn>
+		void submit(Fn&& fn)
+		{
+			using Command = std::decay_t<Fn>;
+			static_assert(alignof(Command) <= alignof(std::max_align_t), "Over-aligned render commands are not supported");
+
+			void* payload = allocate(sizeof(Command), alignof(Command));
+			new (payload) Command(std::forward<Fn>(fn));
+			m_Commands.push_back({ payload, [](void* command, bool run)
+			{
+				if (run)
+					(*static_cast<Command*>(command))();
+				static_cast<Command*>(command)->~Command();
+			}});
+		}
+
+		// Runs every recorded command then resets the queue, memory blocks are kept for the next frame
+		void execute();
+		size_t getCommandCount() const { return m_Commands.size(); }
+
+	private:
+		struct Command
+		{
+			void* payload;
+			void (*invoke)(void* payload, bool run);
+		};
+
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> data;
+			size_t size;
+		};
+
+		void* allocate(size_t size, size_t alignment);
+		void reset(bool run);
+
+		std::vector<Command> m_Commands;
+		std::vector<Block> m_Blocks;
+		size_t m_BlockIndex = 0;
+		size_t m_BlockCursor = 0;
+	};
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Framebuffer.hpp"
+
+#include <functional>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace Cardia
+{
+	// Texture declared in a RenderGraph, valid for the frame it was declared in
+	using RenderGraphTexture = uint32_t;
+
+	constexpr RenderGraphTexture invalidRenderGraphTexture = ~0u;
+
+	struct RenderGraphTextureDesc
+	{
+		FramebufferTextureFormat format = FramebufferTextureFormat::None;
+		int width = 0;
+		int height = 0;
+		uint32_t samples = 1;
+		glm::vec4 clearValue { 0.0f }; // Integer formats clear to x, depth formats to 1
+
+		// Whether two textures can share the same memory
+		bool isAliasOf(const RenderGraphTextureDesc& other) const
+		{
+			return format == other.format && width == other.width && height == other.height && samples == other.samples;
+		}
+	};
+
+	// How a pass uses a texture, a barrier goes between a write and a use of another kind
+	enum class RenderGraphAccess
+	{
+		RenderTarget = 0, Sampled, Transfer
+	};
+
+	// Physical side of the graph, only called on the back end
+	class RenderGraphBackend
+	{
+	public:
+		virtual ~RenderGraphBackend() = default;
+
+		virtual uint32_t acquireTexture(const RenderGraphTextureDesc& desc) = 0;
+		virtual void releaseTexture(const RenderGraphTextureDesc& desc, uint32_t texture) = 0;
+		virtual void clearTexture(uint32_t texture, const RenderGraphTextureDesc& desc) = 0;
+
+		// Renders into colors, 0 leaves a location unused, and depth over width x height pixels
+		virtual void beginPass(const std::vector<uint32_t>& colors, uint32_t depth, int width, int height) = 0;
+		virtual void endPass() = 0;
+		// Makes the writes of earlier passes visible to the given use
+		virtual void barrier(RenderGraphAccess access) = 0;
+
+		// Asynchronous copy of an integer texture region, handed back by pollPixels once the GPU is done
+		virtual void requestPixels(uint32_t texture, const PixelRegion& region) = 0;
+		virtual bool pollPixels(PixelRegion& region, std::vector<int>& pixels) = 0;
+
+		static std::unique_ptr<RenderGraphBackend> create();
+	};
+
+	// One executed graph. Built by the front end, its textures only exist while the back end replays it
+	class RenderGraphFrame
+	{
+	public:
+		// Back end only, between the passes of this frame
+		uint32_t getTexture(RenderGraphTexture texture) const { return m_Textures[texture]; }
+		RenderGraphBackend& getBackend() const { return *m_Backend; }
+
+	private:
+		friend class RenderGraph;
+
+		struct Import
+		{
+			RenderGraphTexture texture;
+			const Framebuffer* framebuffer;
+			uint32_t attachmentIndex;
+		};
+
+		struct PassCommands
+		{
+			std::vector<RenderGraphTexture> colors; // invalidRenderGraphTexture where an output was culled
+			RenderGraphTexture depth = invalidRenderGraphTexture;
+			std::vector<RenderGraphTexture> clears;
+			std::vector<RenderGraphAccess> barriers;
+			int width = 0;
+			int height = 0;
+		};
+
+		void acquire();
+		void beginPass(uint32_t pass);
+		void endPass();
+		void release();
+
+		std::shared_ptr<RenderGraphBackend> m_Backend;
+		std::vector<RenderGraphTextureDesc> m_Descs; // Indexed by texture
+		std::vector<uint32_t> m_TextureSlots; // Physical texture of each transient texture
+		std::vector<RenderGraphTextureDesc> m_Slots;
+		std::vector<Import> m_Imports;
+		std::vector<PassCommands> m_Passes; // Kept passes only
+
+		// Written on the back end
+		std::vector<uint32_t> m_Textures;
+		std::vector<uint32_t> m_SlotTextures;
+	};
+
+	// Passes declared every frame with the textures they write and read. Passes nothing depends on are culled,
+	// so are the outputs nobody reads, transient textures with disjoint lifetimes share memory.
+	class RenderGraph
+	{
+	public:
+		class Builder
+		{
+		public:
+			// The pass renders into texture, after clearing it to its clear value when clear is set.
+			// Without clear it adds to what earlier passes wrote, those passes are kept with it
+			void write(RenderGraphTexture texture, bool clear = false);
+			// Attachment only used inside the pass, e.g. its depth buffer. Never culled while the pass is kept
+			void writeLocal(RenderGraphTexture texture, bool clear = true);
+			void read(RenderGraphTexture texture, RenderGraphAccess access = RenderGraphAccess::Sampled);
+			// Kept even when nothing reads its outputs, e.g. it reads pixels back
+			void sideEffect();
+
+		private:
+			friend class RenderGraph;
+			Builder(RenderGraph& graph, uint32_t pass) : m_Graph(graph), m_Pass(pass) {}
+
+			RenderGraph& m_Graph;
+			uint32_t m_Pass;
+		};
+
+		// Front end, called in pass order by execute. Work for the back end is submitted from there,
+		// the frame resolves textures once it runs
+		using ExecuteFn = std::function<void(const std::shared_ptr<RenderGraphFrame>& frame)>;
+
+		RenderGraph();
+
+		// Forgets the passes and textures of the previous frame
+		void reset();
+
+		RenderGraphTexture createTexture(std::string name, const RenderGraphTextureDesc& desc);
+		// Color attachment of a framebuffer owned elsewhere, whatever writes it is kept
+		RenderGraphTexture importTexture(std::string name, const Framebuffer& framebuffer, uint32_t attachmentIndex, const RenderGraphTextureDesc& desc);
+
+		void addPass(std::string name, const std::function<void(Builder&)>& setup, ExecuteFn execute);
+
+		// Culls and places the passes, then records the kept ones in order
+		void execute();
+
+		// Back end only
+		bool pollPixels(PixelRegion& region, std::vector<int>& pixels) { return m_Backend->pollPixels(region, pixels); }
+
+		// Result of the last execute
+		uint32_t getKeptPassCount() const { return m_KeptPassCount; }
+		uint32_t getPassCount() const { return static_cast<uint32_t>(m_Passes.size()); }
+		uint32_t getPhysicalTextureCount() const { return m_PhysicalTextureCount; }
+
+	private:
+		struct TextureNode
+		{
+			std::string name;
+			RenderGraphTextureDesc desc;
+			const Framebuffer* framebuffer = nullptr; // Imported
+			uint32_t attachmentIndex = 0;
+		};
+
+		struct TextureAccess
+		{
+			RenderGraphTexture texture;
+			RenderGraphAccess access;
+			bool write;
+			bool clear;
+			bool passLocal = false;
+		};
+
+		struct PassNode
+		{
+			std::string name;
+			std::vector<TextureAccess> accesses;
+			ExecuteFn execute;
+			bool sideEffect = false;
+		};
+
+		std::shared_ptr<RenderGraphFrame> compile(std::vector<uint32_t>& keptPasses);
+
+		std::shared_ptr<RenderGraphBackend> m_Backend;
+		std::vector<TextureNode> m_Textures;
+		std::vector<PassNode> m_Passes;
+
+		uint32_t m_KeptPassCount = 0;
+		uint32_t m_PhysicalTextureCount = 0;
+	};
+}
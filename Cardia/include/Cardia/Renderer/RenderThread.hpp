@@ -0,0 +1,40 @@
+#pragma once
+
+#include "RenderCommandQueue.hpp"
+#include "RendererContext.hpp"
+
+
+namespace Cardia
+{
+	// Front end / back end split of the renderer. The front end records commands for frame N+1 while
+	// the back end thread replays frame N, the context is handed to whichever side issues GL calls.
+	// Only single-threaded for now, sync() replays the frame on the calling thread. Threading stays off until every
+	// GL object created or deleted by the front end (asset loads, mesh frees, light buffers) is submitted, since the
+	// front end owns no context between sync() and kick().
+	class RenderThread
+	{
+	public:
+		static void init(RendererContext& context, bool threaded = false);
+		static void quit();
+
+		template<typename Fn>
+		static void submit(Fn&& fn)
+		{
+			getSubmitQueue().submit(std::forward<Fn>(fn));
+		}
+
+		// Hands the recorded frame and the context over to the back end
+		static void kick();
+		// Waits until the back end is idle and the calling thread owns the context again.
+		// When single-threaded, the recorded commands are replayed here instead.
+		static void sync();
+
+		// Not exposed to applications until the front end is free of GL calls, see above
+		static void setThreaded(bool state);
+		static bool isThreaded();
+
+	private:
+		static RenderCommandQueue& getSubmitQueue();
+		static void run();
+	};
+}
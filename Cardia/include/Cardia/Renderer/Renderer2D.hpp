@@ -2,6 +2,7 @@
 
 #include "Camera.hpp"
 #include "Texture.hpp"
+#include "TextureAtlas.hpp"
 #include "Cardia/DataStructure/Mesh.hpp"
 
 #include <glm/glm.hpp>
@@ -10,6 +11,8 @@
 
 namespace Cardia
 {
+	class MeshRenderer;
+	class RetainedSprites;
 	class Renderer2D
 	{
 	public:
@@ -21,10 +24,30 @@ namespace Cardia
 		struct Stats {
 			int drawCalls;
 			int triangleCount;
+			int culledCount; // Objects rejected by frustum culling
+			int stateChanges; // Binds and toggles sent to the driver
+			int elidedStateChanges; // Redundant ones skipped by the render API
 		};
 
 		static Stats& getStats();
 
+		// Sprites are drawn as instances of a unit quad, the CPU-expanded vertex path is kept as a fallback
+		static void setInstancedSprites(bool state);
+		static bool isInstancedSprites();
+
+		// Draws every layer from the highest Y to the lowest instead of relying on depth
+		static void setTopDownSorting(bool state);
+		static bool isTopDownSorting();
+
+		// Opaque scene sprites stay in GPU memory and are only uploaded again when they change.
+		// Needs instanced sprites, top-down sorting reorders every frame and turns it off.
+		static void setRetainedSprites(bool state);
+		static bool isRetainedSprites();
+
+		// Instanced sprites and static meshes are frustum culled by compute shaders, the scene skips its CPU culling
+		static void setGpuCulling(bool state);
+		static bool isGpuCulling();
+
 		static void drawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
 		static void drawRect(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void drawRect(const glm::vec3& position, const glm::vec2& size, const Texture2D* texture, float tilingFactor = 1.0f);
@@ -32,8 +55,17 @@ namespace Cardia
 		static void drawRect(const glm::vec3& position, const glm::vec2& size, const Texture2D* texture, const glm::vec4& color, float tilingFactor = 1.0f);
 		static void drawRect(const glm::vec3& position, const glm::vec2& size, float rotation, const Texture2D* texture, const glm::vec4& color, float tilingFactor = 1.0f);
 		static void drawRect(const glm::mat4& transform, const glm::vec4& color);
-		static void drawRect(const glm::mat4& transform, const Texture2D* texture, const glm::vec4& color, float tilingFactor = 1.0f, int32_t zIndex = 0, float entityID = -1);
+		// uvRect is the part of texture the sprite samples, e.g. an atlas region
+		static void drawRect(const glm::mat4& transform, const Texture2D* texture, const glm::vec4& color, float tilingFactor = 1.0f, int32_t zIndex = 0, int32_t entityID = -1, const glm::vec4& uvRect = fullTextureRect);
+
+		// Draws every sprite of sprites, uploading the ones changed since its last draw
+		static void drawRetainedSprites(RetainedSprites& sprites);
+
+		// Static meshes are drawn after the sprites through StaticMeshPool, the renderer is kept alive until then
+		static void drawMesh(std::shared_ptr<MeshRenderer> meshRenderer, const glm::mat4& transform, int32_t entityID = -1);
 
 		static void addLight(const Component::Transform& transform, const Component::Light& lightComponent);
+		// Reported by the scene for objects it did not submit
+		static void addCulledObjects(int count);
 	};
 }
\ No newline at end of file
@@ -9,5 +9,8 @@ namespace Cardia
 		virtual ~RendererContext() = default;
 		virtual void init() = 0;
 		virtual void swapBuffers() = 0;
+		// Binds or unbinds the context on the calling thread
+		virtual void makeCurrent() = 0;
+		virtual void releaseCurrent() = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Batch.hpp"
+#include "Texture.hpp"
+#include "Cardia/DataStructure/Bounds.hpp"
+#include "Cardia/DataStructure/RangeAllocator.hpp"
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+
+namespace Cardia
+{
+	// Instances of Renderer2D's persistent retained sprite buffer
+	constexpr uint32_t maxRetainedSprites = 1 << 18;
+	// World units covered by one group, groups are frustum culled as a whole
+	constexpr float retainedSpriteCellSize = 32.0f;
+
+	struct RetainedSpriteUpload
+	{
+		uint32_t firstInstance;
+		uint32_t instanceCount; // Read back to back from RetainedSpriteFrame::uploadData
+	};
+
+	struct RetainedSpriteDraw
+	{
+		BatchSpecification specification;
+		std::shared_ptr<Texture2D> texture;
+		uint32_t firstInstance;
+		uint32_t instanceCount;
+	};
+
+	// What a frame replays: the changed instances, then one instanced draw per group
+	struct RetainedSpriteFrame
+	{
+		std::vector<RetainedSpriteUpload> uploads;
+		std::vector<SpriteInstance> uploadData;
+		std::vector<RetainedSpriteDraw> draws;
+		std::vector<std::shared_ptr<Texture2D>> releasedTextures; // Dropped by the front end, released with the frame
+	};
+
+	// Front end bookkeeping of sprites kept in GPU memory between frames.
+	// Sprites sharing a specification, a texture and a grid cell are packed in one range of the buffer and drawn together,
+	// only added, changed or moved instances are uploaded again.
+	class RetainedSprites
+	{
+	public:
+		using Handle = uint32_t;
+		static constexpr Handle invalidHandle = std::numeric_limits<Handle>::max();
+		// Specification key, texture and grid cell of a group
+		using GroupKey = std::tuple<uint64_t, const Texture2D*, int32_t, int32_t>;
+
+		RetainedSprites();
+
+		// Returns invalidHandle when the buffer is full, the sprite has to be drawn with drawRect then
+		Handle add(const glm::mat4& transform, const std::shared_ptr<Texture2D>& texture, const glm::vec4& color, const glm::vec4& uvRect, float tilingFactor, int32_t zIndex, int32_t entityID);
+		// False when the sprite had to move to a group the buffer has no room for, the handle is released then
+		bool update(Handle handle, const glm::mat4& transform, const std::shared_ptr<Texture2D>& texture, const glm::vec4& color, const glm::vec4& uvRect, float tilingFactor, int32_t zIndex, int32_t entityID);
+		void remove(Handle handle);
+
+		// Uploads everything again on the next record, the buffer was filled by someone else
+		void invalidate();
+		// Moves the pending uploads to frame and lists the draws of the groups inside frustum.
+		// Returns the number of sprites culled with their group.
+		uint32_t record(RetainedSpriteFrame& frame, const Frustum& frustum);
+
+		uint32_t getId() const { return m_Id; }
+		uint32_t getSpriteCount() const { return static_cast<uint32_t>(m_Locations.size() - m_FreeHandles.size()); }
+
+	private:
+		struct Group
+		{
+			BatchSpecification specification {};
+			std::shared_ptr<Texture2D> texture;
+			glm::ivec2 cell {};
+			AABB bounds; // Only grows while the group lives, stays conservative when sprites leave
+			uint32_t firstInstance = RangeAllocator::invalidOffset;
+			uint32_t capacity = 0;
+			std::vector<SpriteInstance> instances;
+			std::vector<Handle> handles;
+			bool relocated = false; // Uploaded as a whole on the next record
+		};
+
+		struct Location
+		{
+			uint32_t group;
+			uint32_t index;
+		};
+
+		uint32_t findGroup(const BatchSpecification& specification, const std::shared_ptr<Texture2D>& texture, const glm::ivec2& cell);
+		bool insert(Handle handle, uint32_t group, SpriteInstance sprite, const AABB& bounds);
+		void erase(Handle handle);
+		void releaseGroup(uint32_t groupIndex);
+
+		RangeAllocator m_Allocator { maxRetainedSprites };
+		std::vector<Group> m_Groups;
+		std::vector<uint32_t> m_FreeGroups;
+		std::map<GroupKey, uint32_t> m_GroupLookup;
+
+		std::vector<Location> m_Locations; // Indexed by handle
+		std::vector<Handle> m_FreeHandles;
+
+		std::vector<Location> m_Dirty;
+		std::vector<std::shared_ptr<Texture2D>> m_ReleasedTextures;
+		uint32_t m_Id;
+	};
+}
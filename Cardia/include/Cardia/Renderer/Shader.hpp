@@ -4,22 +4,56 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Cardia
 {
+	// Compile-time switches of a shader, every requested combination is compiled with its own #defines
+	namespace ShaderFeature
+	{
+		enum : uint8_t
+		{
+			None = 0,
+			Textured = 1 << 0, // CD_TEXTURED: samples u_Textures, vertex color only otherwise
+			Lit = 1 << 1, // CD_LIT: clustered lighting
+			AlphaTested = 1 << 2, // CD_ALPHA_TEST: discards fully transparent fragments
+			Instanced = 1 << 3 // CD_INSTANCED: unit quad expanded from per-instance sprite attributes
+		};
+	}
+	using ShaderFeatures = uint8_t;
+
+	// "#define CD_..." lines of the features and CD_MAX_TEXTURE_SLOTS, inserted right after the #version directive
+	std::string ShaderFeatureDefines(ShaderFeatures features);
+
 	class Shader
 	{
 	public:
 		virtual ~Shader() = default;
 		virtual void bind() const = 0;
 		virtual void unbind() const = 0;
+		// False while the driver still compiles the program in the background, binding it then would wait
+		virtual bool isReady() const { return true; }
 
 		virtual void setFloat4(const std::string& name, const glm::vec4& value) = 0;
+		virtual void setFloat4Array(const std::string& name, const glm::vec4* values, int count) = 0;
 		virtual void setFloat3(const std::string& name, const glm::vec3& value) = 0;
 		virtual void setMat4(const std::string& name, const glm::mat4& value) = 0;
 		virtual void setInt(const std::string& name, int value) = 0;
+		// Sampler arrays are already bound to consecutive texture slots when the program is linked
 		virtual void setIntArray(const std::string& name, int* values, int count) = 0;
 
-		static std::unique_ptr<Shader> create(std::initializer_list<std::string> filePaths);
+		static std::unique_ptr<Shader> create(const std::vector<std::string>& filePaths, ShaderFeatures features = ShaderFeature::None);
+	};
+
+	// Permutations of one set of sources, each compiled on its first request
+	class ShaderVariants
+	{
+	public:
+		explicit ShaderVariants(std::vector<std::string> filePaths);
+		Shader& get(ShaderFeatures features);
+
+	private:
+		std::vector<std::string> m_FilePaths;
+		std::unordered_map<ShaderFeatures, std::unique_ptr<Shader>> m_Variants;
 	};
 }
\ No newline at end of file
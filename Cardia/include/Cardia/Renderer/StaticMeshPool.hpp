@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Shader.hpp"
+#include "Texture.hpp"
+#include "Cardia/DataStructure/SubMesh.hpp"
+#include "Cardia/DataStructure/Bounds.hpp"
+
+#include <glm/glm.hpp>
+#include <limits>
+
+
+namespace Cardia
+{
+	// Location of a sub-mesh inside one of the shared geometry arenas
+	struct MeshAllocation
+	{
+		static constexpr uint32_t invalidArena = std::numeric_limits<uint32_t>::max();
+
+		uint32_t arena = invalidArena;
+		uint32_t firstVertex {};
+		uint32_t vertexCount {};
+		uint32_t firstIndex {};
+		uint32_t indexCount {};
+
+		bool isValid() const { return arena != invalidArena; }
+	};
+
+	// Depth-only pass laid before the shading pass, which then only tests depth for equality
+	struct MeshDepthPrePass
+	{
+		Shader* shader;
+		glm::vec3 viewPosition; // Draws of an arena are sorted nearest first
+	};
+
+	// Static geometry shared by every mesh: one vertex/index arena per vertex format,
+	// drawn with a single multi-draw indirect call per arena and texture set
+	class StaticMeshPool
+	{
+	public:
+		static void init();
+		static void quit();
+
+		// Must be called with the context current
+		static MeshAllocation allocate(const SubMesh& subMesh, VertexFormat format);
+		static void free(const MeshAllocation& allocation);
+
+		// Back end only, draws are recorded by submit and issued by flush.
+		// With a frustum, draws are culled and compacted by a compute shader instead of drawn as submitted
+		static void submit(const MeshAllocation& allocation, const AABB& bounds, const glm::mat4& model, const Texture2D* texture, int32_t entityID);
+		static void flush(Shader& shader, const Frustum* gpuCulling = nullptr, const MeshDepthPrePass* depthPrePass = nullptr);
+	};
+}
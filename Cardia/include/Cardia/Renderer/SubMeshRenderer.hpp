@@ -2,8 +2,7 @@
 
 
 #include "Cardia/DataStructure/SubMesh.hpp"
-#include "VertexArray.hpp"
-#include "Buffer.hpp"
+#include "StaticMeshPool.hpp"
 
 namespace Cardia
 {
@@ -11,12 +10,17 @@ namespace Cardia
 	{
 	public:
 		SubMeshRenderer() = default;
+		~SubMeshRenderer();
+		SubMeshRenderer(const SubMeshRenderer&) = delete;
+		SubMeshRenderer& operator=(const SubMeshRenderer&) = delete;
+		SubMeshRenderer(SubMeshRenderer&& other) noexcept;
+		SubMeshRenderer& operator=(SubMeshRenderer&& other) noexcept;
 
-		void SubmitSubMesh(SubMesh& subMesh);
-		void Draw();
+		void SubmitSubMesh(SubMesh& subMesh, VertexFormat format = VertexFormat::Standard);
+		// Records a draw of the pooled geometry, back end only
+		void Submit(const glm::mat4& model, const Texture2D* texture, int32_t entityID) const;
 	private:
-		std::unique_ptr<VertexArray> m_VertexArray;
-		std::unique_ptr<VertexBuffer> m_VertexBuffer;
-		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		MeshAllocation m_Allocation; // Released back to StaticMeshPool on destruction
+		AABB m_Bounds;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Texture.hpp"
+
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Cardia
+{
+	// Sprites keep the whole texture unless they sample a region of it
+	constexpr glm::vec4 fullTextureRect { 0.0f, 0.0f, 1.0f, 1.0f };
+
+	// Part of an atlas a sprite was packed into
+	struct AtlasRegion
+	{
+		glm::ivec4 pixels; // xy: bottom left corner, zw: size
+		glm::vec4 uvRect; // Same, in texture coordinates
+	};
+
+	// Many sprites in one texture, they end up in the same batch. Built once from a folder of images by pack(),
+	// loaded through AssetsManager from the .atlas metadata, the texture being the .ktx2 next to it.
+	class TextureAtlas
+	{
+	public:
+		TextureAtlas(std::shared_ptr<Texture2D> texture, std::unordered_map<std::string, AtlasRegion> regions);
+
+		const std::shared_ptr<Texture2D>& getTexture() const { return m_Texture; }
+		// Regions are named after the file they were packed from, without its extension
+		const AtlasRegion* findRegion(const std::string& name) const;
+		const std::unordered_map<std::string, AtlasRegion>& getRegions() const { return m_Regions; }
+
+		// Import step: packs the images of folder and writes atlasPath (.atlas) along with its texture (.ktx2)
+		static bool pack(const std::filesystem::path& folder, const std::filesystem::path& atlasPath);
+		// Regions are empty when the metadata cannot be read
+		static std::unique_ptr<TextureAtlas> load(const std::filesystem::path& atlasPath, std::shared_ptr<Texture2D> texture);
+
+	private:
+		std::shared_ptr<Texture2D> m_Texture;
+		std::unordered_map<std::string, AtlasRegion> m_Regions;
+	};
+}
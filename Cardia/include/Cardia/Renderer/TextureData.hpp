@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace Cardia
+{
+	// Storage format of a texture, BCn formats stay compressed in video memory
+	enum class TextureFormat
+	{
+		None = 0,
+		R8, RG8, RGB8, RGBA8,
+		BC1, // RGB, 4 bits per pixel
+		BC1A, // BC1 with 1-bit alpha
+		BC3, // RGBA, 8 bits per pixel
+		BC4, // R, 4 bits per pixel
+		BC5, // RG, 8 bits per pixel
+		BC7 // RGBA, 8 bits per pixel, better quality than BC3
+	};
+
+	bool TextureFormatIsCompressed(TextureFormat format);
+	bool TextureFormatHasAlpha(TextureFormat format);
+	// Bytes of one mip level, compressed formats are stored in 4x4 blocks
+	uint64_t TextureLevelSize(TextureFormat format, uint32_t width, uint32_t height);
+	// Levels of a full mip chain, down to 1x1
+	uint32_t MipLevelCount(uint32_t width, uint32_t height);
+
+	struct TextureLevel
+	{
+		uint32_t width;
+		uint32_t height;
+		uint64_t offset; // Into TextureData::bytes
+		uint64_t size;
+	};
+
+	// Pixels of a texture as stored in a container file, level 0 is the largest
+	struct TextureData
+	{
+		TextureFormat format = TextureFormat::None;
+		std::vector<TextureLevel> levels;
+		std::vector<uint8_t> bytes;
+	};
+
+	// Whether the file is a KTX2 or DDS container, judged by its extension
+	bool IsTextureContainer(const std::string& path);
+	// Reads a 2D texture and its precomputed mip chain, rows bottom-up like the rest of the engine's textures.
+	// DDS files and KTX2 files without a "ru" KTXorientation are top-down and flipped on load, except BC7 which is
+	// kept as stored with a warning. False on unsupported or invalid files.
+	bool LoadTextureContainer(const std::string& path, TextureData& data);
+	// Writes uncompressed data as KTX2, rows bottom-up
+	bool SaveTextureContainer(const std::string& path, const TextureData& data);
+}
@@ -13,8 +13,11 @@ namespace Cardia
 		virtual void unbind() const = 0;
 		virtual void setVertexBuffer (std::unique_ptr<VertexBuffer> vertexBuffer) = 0;
 		virtual void setIndexBuffer (std::unique_ptr<IndexBuffer> indexBuffer) = 0;
+		// Attributes of the instance buffer advance once per instance and follow the vertex buffer ones
+		virtual void setInstanceBuffer (std::unique_ptr<VertexBuffer> instanceBuffer) = 0;
 		virtual VertexBuffer& getVertexBuffer () = 0;
 		virtual IndexBuffer& getIndexBuffer () const = 0;
+		virtual VertexBuffer& getInstanceBuffer () = 0;
 
 
 		static std::unique_ptr<VertexArray> create();
@@ -1,10 +1,13 @@
 #include "cdpch.hpp"
 #include "Cardia/Application.hpp"
 #include "Cardia/Renderer/Renderer2D.hpp"
+#include "Cardia/Renderer/GpuProfiler.hpp"
 #include "Cardia/Renderer/RenderAPI.hpp"
+#include "Cardia/Renderer/RenderThread.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
 #include "Cardia/Scripting/ScriptEngine.hpp"
 
-#include <GLFW/glfw3.h>
+#include <chrono>
 #include <Cardia/Project/AssetsManager.hpp>
 
 namespace Cardia
@@ -16,40 +19,91 @@ namespace Cardia
 		cdCoreAssert(!s_Instance, "Application already exists");
 		s_Instance = this;
 
-		m_Window = Window::Create();
+		WinProperties properties;
+		properties.headless = s_Headless;
+		m_Window = Window::Create(properties);
 		m_Window->setEventCallback([this](Event& e)
 		{
 			EventDispatcher dispatcher(e);
 			dispatcher.dispatch<WindowCloseEvent>(CD_BIND_EVENT_FN(Application::onWinClose));
-			m_ImGuiLayer->onEvent(e);
+			if (m_ImGuiLayer)
+				m_ImGuiLayer->onEvent(e);
 			OnEvent(e);
 		});
 
-		m_ImGuiLayer = std::make_unique<ImGuiLayer>();
+		if (!s_Headless)
+			m_ImGuiLayer = std::make_unique<ImGuiLayer>();
 	}
 
 	void Application::Run()
 	{
 		RenderAPI::init();
+		GpuProfiler::init();
 		Renderer2D::init();
+		if (s_Headless)
+		{
+			FramebufferSpec spec { m_Window->getWidth(), m_Window->getHeight() };
+			spec.attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::Depth };
+			m_OffscreenFramebuffer = Framebuffer::create(spec);
+		}
+		RenderThread::init(m_Window->getContext());
 
+		const auto start = std::chrono::steady_clock::now();
 		float time = 0.0f;
+		uint32_t frameCount = 0;
 		while (m_Running)
 		{
-			Time::m_DeltaTime = static_cast<float>(glfwGetTime()) - time;
+			const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+			Time::m_DeltaTime = elapsed.count() - time;
 			time += Time::m_DeltaTime.seconds();
 
+			// There is no default framebuffer to draw into
+			if (m_OffscreenFramebuffer)
+				RenderThread::submit([this] { m_OffscreenFramebuffer->Bind(); });
+
+			// Records this frame while the render thread replays the previous one
 			OnUpdate();
 
-			m_ImGuiLayer->Begin();
-			OnImGuiDraw();
-			m_ImGuiLayer->End();
+			// ImGui, events and assets loading issue GL calls directly, they need the context back.
+			// Assets are collected before ImGui so the recorded frame still owns everything it references.
+			RenderThread::sync();
+			AssetsManager::Instance().CollectionRoutine(Time::m_DeltaTime);
+
+			if (m_ImGuiLayer)
+			{
+				GpuProfiler::get().begin(GpuPass::ImGui);
+				m_ImGuiLayer->Begin();
+				OnImGuiDraw();
+				m_ImGuiLayer->End();
+				GpuProfiler::get().end(GpuPass::ImGui);
+				// ImGui's backend binds its own program, buffers and textures
+				RenderAPI::get().invalidateStateCache();
+			}
+			// The back end replayed the scene before ImGui, the GPU frame ends here
+			GpuProfiler::get().nextFrame();
 
 			m_Window->onUpdate();
-			AssetsManager::Instance().CollectionRoutine(Time::m_DeltaTime);
 
+			RenderThread::kick();
+
+			if (s_FrameLimit && ++frameCount == s_FrameLimit)
+				m_Running = false;
+		}
+		RenderThread::quit();
+		if (s_FrameLimit && frameCount)
+		{
+			const std::chrono::duration<float, std::milli> total = std::chrono::steady_clock::now() - start;
+			Log::coreInfo("{0} frames in {1:.1f} ms, {2:.3f} ms per frame", frameCount, total.count(), total.count() / static_cast<float>(frameCount));
+		}
+		if (RenderAPI::getAPI() == RenderAPI::API::None)
+		{
+			const auto counters = NullRecorder::getCounters();
+			Log::coreInfo("Null renderer: {0} calls, {1} draws, {2} dispatches, {3} bytes uploaded",
+				counters.calls, counters.drawCalls, counters.dispatches, counters.uploadedBytes);
 		}
+		m_OffscreenFramebuffer.reset();
 		Renderer2D::quit();
+		GpuProfiler::quit();
 	}
 
 	bool Application::onWinClose(WindowCloseEvent& e)
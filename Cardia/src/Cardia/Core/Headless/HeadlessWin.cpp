@@ -0,0 +1,33 @@
+#if defined(__linux__)
+
+#include "cdpch.hpp"
+#include "Cardia/Core/Headless/HeadlessWin.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLHeadlessContext.hpp"
+#include "Cardia/Renderer/Null/NullContext.hpp"
+#include "Cardia/Renderer/Renderer.hpp"
+
+
+namespace Cardia
+{
+	HeadlessWin::HeadlessWin(const WinProperties& properties)
+		: m_Width(properties.width), m_Height(properties.height)
+	{
+		switch (RenderAPI::getAPI())
+		{
+			case RenderAPI::API::OpenGL:
+				m_RendererContext = std::make_unique<OpenGLHeadlessContext>();
+				break;
+			case RenderAPI::API::None:
+				m_RendererContext = std::make_unique<NullContext>();
+				break;
+		}
+		m_RendererContext->init();
+	}
+
+	void HeadlessWin::onUpdate()
+	{
+		m_RendererContext->swapBuffers();
+	}
+}
+
+#endif
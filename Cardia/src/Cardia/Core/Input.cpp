@@ -11,16 +11,23 @@ namespace Cardia
 		return static_cast<GLFWwindow*>(Application::get().getWindow().getNativeWin());
 	}
 
+	// Headless runs have no window, nothing is ever pressed
 	bool Input::isKeyPressed(int keyCode) {
+		if (!getNativeWin())
+			return false;
 		auto state = glfwGetKey(getNativeWin(), keyCode);
 		return state == GLFW_PRESS || state == GLFW_REPEAT;
 	}
 
 	bool Input::isMouseButtonPressed(int button) {
+		if (!getNativeWin())
+			return false;
 		return glfwGetMouseButton(getNativeWin(), button) == GLFW_PRESS;
 	}
 
 	glm::vec2 Input::getMousePos() {
+		if (!getNativeWin())
+			return {};
 		double x, y;
 		glfwGetCursorPos(getNativeWin(), &x, &y);
 
@@ -3,6 +3,7 @@
 
 #include "cdpch.hpp"
 #include "Cardia/Core/Windows/WindowsWin.hpp"
+#include "Cardia/Core/Headless/HeadlessWin.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLContext.hpp"
 #include "Cardia/Renderer/Renderer.hpp"
 #include "Cardia/Scripting/ScriptEngine.hpp"
@@ -14,6 +15,11 @@ namespace Cardia
 
 	std::unique_ptr<Window> Window::Create(const WinProperties& properties)
 	{
+#if defined(__linux__)
+		if (properties.headless)
+			return std::make_unique<HeadlessWin>(properties);
+#endif
+		cdCoreAssert(!properties.headless, "Headless windows are only supported on Linux");
 		return std::make_unique<WindowsWin>(properties);
 	}
 
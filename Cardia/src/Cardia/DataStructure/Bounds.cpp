@@ -0,0 +1,70 @@
+#include "cdpch.hpp"
+#include "Cardia/DataStructure/Bounds.hpp"
+
+
+namespace Cardia
+{
+	void AABB::Expand(const glm::vec3& point)
+	{
+		min = glm::min(min, point);
+		max = glm::max(max, point);
+	}
+
+	void AABB::Expand(const AABB& other)
+	{
+		if (!other.IsValid())
+			return;
+		min = glm::min(min, other.min);
+		max = glm::max(max, other.max);
+	}
+
+	AABB AABB::Transform(const glm::mat4& transform) const
+	{
+		if (!IsValid())
+			return {};
+
+		const glm::vec3 center = (min + max) * 0.5f;
+		const glm::vec3 extents = (max - min) * 0.5f;
+
+		const glm::vec3 newCenter = transform * glm::vec4(center, 1.0f);
+		const glm::mat3 absolute {
+			glm::abs(glm::vec3(transform[0])),
+			glm::abs(glm::vec3(transform[1])),
+			glm::abs(glm::vec3(transform[2]))
+		};
+		const glm::vec3 newExtents = absolute * extents;
+
+		return { newCenter - newExtents, newCenter + newExtents };
+	}
+
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		const auto row = [&viewProjection](int index)
+		{
+			return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index]);
+		};
+
+		m_Planes[0] = row(3) + row(0); // Left
+		m_Planes[1] = row(3) - row(0); // Right
+		m_Planes[2] = row(3) + row(1); // Bottom
+		m_Planes[3] = row(3) - row(1); // Top
+		m_Planes[4] = row(3) + row(2); // Near
+		m_Planes[5] = row(3) - row(2); // Far
+	}
+
+	bool Frustum::Intersects(const AABB& box) const
+	{
+		for (const auto& plane : m_Planes)
+		{
+			// Corner of the box the furthest along the plane normal
+			const glm::vec3 positive {
+				plane.x >= 0.0f ? box.max.x : box.min.x,
+				plane.y >= 0.0f ? box.max.y : box.min.y,
+				plane.z >= 0.0f ? box.max.z : box.min.z
+			};
+			if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+				return false;
+		}
+		return true;
+	}
+}
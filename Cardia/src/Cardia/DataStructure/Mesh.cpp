@@ -56,7 +56,9 @@ namespace Cardia
 				else
 					vertex.textureCoord = glm::vec2(0.0f, 0.0f);
 				vertices.emplace_back(vertex);
+				subMesh.GetBounds().Expand(vertex.position);
 			}
+			mesh.GetBounds().Expand(subMesh.GetBounds());
 
 			for (unsigned int faceIndex = 0; faceIndex < ai_mesh->mNumFaces; faceIndex++)
 			{
@@ -0,0 +1,50 @@
+#include "cdpch.hpp"
+#include "Cardia/DataStructure/RadixSort.hpp"
+
+#include <array>
+
+
+namespace Cardia
+{
+	void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch)
+	{
+		if (items.size() < 2)
+			return;
+
+		constexpr uint32_t digitCount = sizeof(uint64_t);
+		std::array<std::array<uint32_t, 256>, digitCount> histograms {};
+		for (const auto& item : items)
+		{
+			for (uint32_t digit = 0; digit < digitCount; ++digit)
+				histograms[digit][(item.key >> (digit * 8)) & 0xff]++;
+		}
+
+		scratch.resize(items.size());
+		auto* source = &items;
+		auto* destination = &scratch;
+		for (uint32_t digit = 0; digit < digitCount; ++digit)
+		{
+			const uint32_t shift = digit * 8;
+			auto& histogram = histograms[digit];
+
+			// Every key shares this digit, the pass would not move anything
+			if (histogram[(items.front().key >> shift) & 0xff] == items.size())
+				continue;
+
+			uint32_t offset = 0;
+			for (auto& count : histogram)
+			{
+				const uint32_t bucketSize = count;
+				count = offset;
+				offset += bucketSize;
+			}
+
+			for (const auto& item : *source)
+				(*destination)[histogram[(item.key >> shift) & 0xff]++] = item;
+			std::swap(source, destination);
+		}
+
+		if (source != &items)
+			items.swap(scratch);
+	}
+}
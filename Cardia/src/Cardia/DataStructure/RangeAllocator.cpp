@@ -0,0 +1,60 @@
+#include "cdpch.hpp"
+#include "Cardia/DataStructure/RangeAllocator.hpp"
+
+
+namespace Cardia
+{
+	RangeAllocator::RangeAllocator(uint32_t capacity)
+		: m_Capacity(capacity), m_FreeSize(capacity)
+	{
+		if (capacity > 0)
+			m_FreeRanges.emplace(0, capacity);
+	}
+
+	uint32_t RangeAllocator::Allocate(uint32_t size)
+	{
+		if (size == 0 || size > m_FreeSize)
+			return invalidOffset;
+
+		for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+		{
+			const auto [offset, rangeSize] = *it;
+			if (rangeSize < size)
+				continue;
+
+			m_FreeRanges.erase(it);
+			if (rangeSize > size)
+				m_FreeRanges.emplace(offset + size, rangeSize - size);
+			m_FreeSize -= size;
+			return offset;
+		}
+		return invalidOffset;
+	}
+
+	void RangeAllocator::Free(uint32_t offset, uint32_t size)
+	{
+		if (size == 0)
+			return;
+
+		cdCoreAssert(offset + size <= m_Capacity, "Freed range is out of the allocator bounds");
+		m_FreeSize += size;
+
+		auto next = m_FreeRanges.lower_bound(offset);
+		if (next != m_FreeRanges.end() && offset + size == next->first)
+		{
+			size += next->second;
+			next = m_FreeRanges.erase(next);
+		}
+
+		if (next != m_FreeRanges.begin())
+		{
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				previous->second += size;
+				return;
+			}
+		}
+		m_FreeRanges.emplace(offset, size);
+	}
+}
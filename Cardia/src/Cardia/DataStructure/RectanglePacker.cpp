@@ -0,0 +1,83 @@
+#include "cdpch.hpp"
+#include "Cardia/DataStructure/RectanglePacker.hpp"
+
+
+namespace Cardia
+{
+	RectanglePacker::RectanglePacker(int width, int height)
+		: m_Skyline({ { 0, 0, width } }), m_Width(width), m_Height(height)
+	{
+	}
+
+	bool RectanglePacker::Pack(int width, int height, glm::ivec2& position)
+	{
+		// Lowest spot first, the narrowest segment breaks ties as it wastes the least space
+		size_t best = m_Skyline.size();
+		int bestY = m_Height;
+		int bestWidth = m_Width + 1;
+		for (size_t index = 0; index < m_Skyline.size(); ++index)
+		{
+			const int y = RestingHeight(index, width);
+			if (y < 0 || y + height > m_Height)
+				continue;
+			if (y < bestY || (y == bestY && m_Skyline[index].width < bestWidth))
+			{
+				best = index;
+				bestY = y;
+				bestWidth = m_Skyline[index].width;
+			}
+		}
+		if (best == m_Skyline.size())
+			return false;
+
+		position = { m_Skyline[best].x, bestY };
+		m_Skyline.insert(m_Skyline.begin() + static_cast<std::ptrdiff_t>(best), { position.x, bestY + height, width });
+
+		// Segments now under the rectangle are shortened or removed
+		const int right = position.x + width;
+		for (size_t index = best + 1; index < m_Skyline.size();)
+		{
+			auto& segment = m_Skyline[index];
+			if (segment.x >= right)
+				break;
+			const int covered = right - segment.x;
+			if (covered < segment.width)
+			{
+				segment.x += covered;
+				segment.width -= covered;
+				break;
+			}
+			m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(index));
+		}
+
+		// Neighbours at the same height become one segment
+		for (size_t index = 0; index + 1 < m_Skyline.size();)
+		{
+			if (m_Skyline[index].y == m_Skyline[index + 1].y)
+			{
+				m_Skyline[index].width += m_Skyline[index + 1].width;
+				m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(index + 1));
+			}
+			else
+			{
+				++index;
+			}
+		}
+		return true;
+	}
+
+	int RectanglePacker::RestingHeight(size_t index, int width) const
+	{
+		if (m_Skyline[index].x + width > m_Width)
+			return -1;
+
+		int y = 0;
+		int remaining = width;
+		for (; remaining > 0; ++index)
+		{
+			y = std::max(y, m_Skyline[index].y);
+			remaining -= m_Skyline[index].width;
+		}
+		return y;
+	}
+}
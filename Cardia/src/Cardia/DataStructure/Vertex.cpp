@@ -0,0 +1,23 @@
+#include "cdpch.hpp"
+#include "Cardia/DataStructure/Vertex.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+
+namespace Cardia
+{
+	PackedVertex PackVertex(const Vertex& vertex)
+	{
+		PackedVertex packed {};
+		packed.position = vertex.position;
+
+		const glm::vec3 normal = glm::length(vertex.normal) > 0.0f ? glm::normalize(vertex.normal) : vertex.normal;
+		packed.normal = glm::i16vec4(glm::round(glm::clamp(glm::vec4(normal, 0.0f), -1.0f, 1.0f) * 32767.0f));
+		packed.color = glm::u8vec4(glm::round(glm::clamp(vertex.color, 0.0f, 1.0f) * 255.0f));
+		packed.textureCoord = glm::packHalf(vertex.textureCoord);
+		packed.tilingFactor = glm::packHalf1x16(vertex.tilingFactor);
+		packed.textureIndex = static_cast<uint16_t>(vertex.textureIndex);
+		packed.entityID = vertex.entityID;
+		return packed;
+	}
+}
@@ -16,10 +16,9 @@ namespace Cardia
 	Scene::Scene(std::string name)
 		: m_Name(std::move(name))
 	{
-		std::string shaderName = "basic";
-		const auto shaderPath = "resources/shaders/" + shaderName;
-		m_BasicShader = AssetsManager::Load<Shader>(shaderPath, AssetsManager::LoadType::Editor);
 		TypeID foo{typeid(Shader), "foobar"};
+		m_Registry.on_destroy<RetainedSprite>().connect<&Scene::OnRetainedSpriteDestroy>(*this);
+		m_Registry.on_destroy<Component::SpriteRenderer>().connect<&Scene::OnSpriteRendererDestroy>(*this);
 	}
 
 	Entity Scene::CreateEntity(const std::string& name)
@@ -71,15 +70,55 @@ namespace Cardia
 			return;
 		}
 
-		Renderer2D::beginScene(*mainCamera, mainCameraTransform);
+		RenderScene(*mainCamera, mainCameraTransform);
+	}
+
+	void Scene::OnUpdateEditor(Camera& editorCamera, const glm::mat4& editorCameraTransform)
+	{
+		RenderScene(editorCamera, editorCameraTransform);
+	}
+
+	void Scene::RenderScene(Camera& camera, const glm::mat4& cameraTransform)
+	{
+		Renderer2D::beginScene(camera, cameraTransform);
+		const Frustum frustum(camera.getProjectionMatrix() * glm::inverse(cameraTransform));
+		int culledCount = 0;
+
+		// Left to the GPU when enabled, the CPU-expanded sprite path has nothing to cull with
+		const bool cullMeshes = !Renderer2D::isGpuCulling();
+		const bool cullSprites = cullMeshes || !Renderer2D::isInstancedSprites();
+
+		// Unit quad of drawRect, the transform gives its world extents
+		static const AABB quadBounds { { -0.5f, -0.5f, 0.0f }, { 0.5f, 0.5f, 0.0f } };
+
+		// Retained sprites are culled per group and never sorted, translucent ones keep their back to front order
+		const bool retainSprites = Renderer2D::isRetainedSprites() && Renderer2D::isInstancedSprites() && !Renderer2D::isTopDownSorting();
+		if (!retainSprites)
+			m_Registry.clear<RetainedSprite>();
 
 		const auto view = m_Registry.view<Component::Transform, Component::SpriteRenderer>();
 		for (const auto entity : view)
 		{
 			auto [transform, spriteRenderer] = view.get<Component::Transform, Component::SpriteRenderer>(entity);
-			Renderer2D::drawRect(transform.getTransform(), spriteRenderer.texture.get(), spriteRenderer.color, spriteRenderer.tillingFactor, spriteRenderer.zIndex, static_cast<float>(entity));
+			if (retainSprites)
+			{
+				if (spriteRenderer.color.a >= 1.0f && RetainSprite(entity, transform, spriteRenderer))
+					continue;
+				m_Registry.remove<RetainedSprite>(entity);
+			}
+
+			const glm::mat4 model = transform.getTransform();
+			if (cullSprites && !frustum.Intersects(quadBounds.Transform(model)))
+			{
+				culledCount++;
+				continue;
+			}
+			Renderer2D::drawRect(model, spriteRenderer.texture.get(), spriteRenderer.color, spriteRenderer.tillingFactor, spriteRenderer.zIndex, static_cast<int32_t>(entity), spriteRenderer.uvRect);
 		}
 
+		if (retainSprites)
+			Renderer2D::drawRetainedSprites(m_RetainedSprites);
+
 		const auto lightView = m_Registry.view<Component::Transform, Component::Light>();
 		for (const auto entity : lightView)
 		{
@@ -87,48 +126,81 @@ namespace Cardia
 			Renderer2D::addLight(transform, light);
 		}
 
-		Renderer2D::endScene();
-
-		m_BasicShader->bind();
-		m_BasicShader->setInt("u_Texture", 0);
 		const auto meshView = m_Registry.view<Component::Transform, Component::MeshRendererC>();
 		for (const auto entity : meshView)
 		{
 			auto [transform, meshRenderer] = meshView.get<Component::Transform, Component::MeshRendererC>(entity);
-			m_BasicShader->setMat4("u_Model", transform.getTransform());
-			meshRenderer.meshRenderer->Draw();
+			const auto mesh = meshRenderer.meshRenderer->GetMesh();
+			if (!mesh)
+				continue;
+
+			const glm::mat4 model = transform.getTransform();
+			if (cullMeshes && mesh->GetBounds().IsValid() && !frustum.Intersects(mesh->GetBounds().Transform(model)))
+			{
+				culledCount++;
+				continue;
+			}
+			Renderer2D::drawMesh(meshRenderer.meshRenderer, model, static_cast<int32_t>(entity));
 		}
+
+		Renderer2D::addCulledObjects(culledCount);
+		Renderer2D::endScene();
 	}
 
-	void Scene::OnUpdateEditor(Camera& editorCamera, const glm::mat4& editorCameraTransform)
+	bool Scene::RetainSprite(entt::entity entity, const Component::Transform& transform, const Component::SpriteRenderer& spriteRenderer)
 	{
-		Renderer2D::beginScene(editorCamera, editorCameraTransform);
-
-		const auto view = m_Registry.view<Component::Transform, Component::SpriteRenderer>();
-		for (const auto entity : view)
+		auto* retained = m_Registry.try_get<RetainedSprite>(entity);
+		if (retained
+			&& retained->position == transform.position
+			&& retained->rotation == transform.rotation
+			&& retained->scale == transform.scale
+			&& retained->color == spriteRenderer.color
+			&& retained->texture == spriteRenderer.texture.get()
+			&& retained->uvRect == spriteRenderer.uvRect
+			&& retained->tilingFactor == spriteRenderer.tillingFactor
+			&& retained->zIndex == spriteRenderer.zIndex)
 		{
-			auto [transform, spriteRenderer] = view.get<Component::Transform, Component::SpriteRenderer>(entity);
-			Renderer2D::drawRect(transform.getTransform(), spriteRenderer.texture.get(), spriteRenderer.color, spriteRenderer.tillingFactor, spriteRenderer.zIndex, static_cast<float>(entity));
+			return true;
 		}
 
-		const auto lightView = m_Registry.view<Component::Transform, Component::Light>();
-		for (const auto entity : lightView)
+		const glm::mat4 model = transform.getTransform();
+		const auto entityID = static_cast<int32_t>(entity);
+		if (!retained)
 		{
-			auto [transform, light] = lightView.get<Component::Transform, Component::Light>(entity);
-			Renderer2D::addLight(transform, light);
+			const auto handle = m_RetainedSprites.add(model, spriteRenderer.texture, spriteRenderer.color, spriteRenderer.uvRect, spriteRenderer.tillingFactor, spriteRenderer.zIndex, entityID);
+			if (handle == RetainedSprites::invalidHandle)
+				return false;
+			retained = &m_Registry.emplace<RetainedSprite>(entity);
+			retained->handle = handle;
 		}
-
-		Renderer2D::endScene();
-
-		m_BasicShader->bind();
-		m_BasicShader->setInt("u_Texture", 0);
-		const auto meshView = m_Registry.view<Component::Transform, Component::MeshRendererC>();
-		for (const auto entity : meshView)
+		else if (!m_RetainedSprites.update(retained->handle, model, spriteRenderer.texture, spriteRenderer.color, spriteRenderer.uvRect, spriteRenderer.tillingFactor, spriteRenderer.zIndex, entityID))
 		{
-			auto [transform, meshRenderer] = meshView.get<Component::Transform, Component::MeshRendererC>(entity);
-			m_BasicShader->setMat4("u_Model", transform.getTransform());
-			meshRenderer.meshRenderer->Draw();
+			// Already released, the component must not release it again
+			retained->handle = RetainedSprites::invalidHandle;
+			return false;
 		}
+
+		retained->position = transform.position;
+		retained->rotation = transform.rotation;
+		retained->scale = transform.scale;
+		retained->color = spriteRenderer.color;
+		retained->texture = spriteRenderer.texture.get();
+		retained->uvRect = spriteRenderer.uvRect;
+		retained->tilingFactor = spriteRenderer.tillingFactor;
+		retained->zIndex = spriteRenderer.zIndex;
+		return true;
+	}
+
+	void Scene::OnRetainedSpriteDestroy(entt::registry& registry, entt::entity entity)
+	{
+		const auto handle = registry.get<RetainedSprite>(entity).handle;
+		if (handle != RetainedSprites::invalidHandle)
+			m_RetainedSprites.remove(handle);
+	}
+
+	void Scene::OnSpriteRendererDestroy(entt::registry& registry, entt::entity entity)
+	{
+		registry.remove<RetainedSprite>(entity);
 	}
 
 	void Scene::OnViewportResize(float width, float height)
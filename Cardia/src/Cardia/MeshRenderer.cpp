@@ -1,5 +1,3 @@
-#include <Cardia/Renderer/Texture.hpp>
-#include <Cardia/Project/AssetsManager.hpp>
 #include "cdpch.hpp"
 
 #include "Cardia/Renderer/MeshRenderer.hpp"
@@ -7,33 +5,28 @@
 namespace Cardia
 {
 
-	void MeshRenderer::SubmitMesh(std::shared_ptr<Mesh> mesh)
+	void MeshRenderer::SubmitMesh(std::shared_ptr<Mesh> mesh, VertexFormat format)
 	{
 		m_Mesh = std::move(mesh);
+		m_VertexFormat = format;
 		m_SubMeshRenderers.erase(m_SubMeshRenderers.begin(), m_SubMeshRenderers.end());
 		auto& subMeshes = m_Mesh->GetSubMeshes();
 
 		for (auto& subMesh : subMeshes)
 		{
 			auto& subMeshRender = m_SubMeshRenderers.emplace_back();
-			subMeshRender.SubmitSubMesh(subMesh);
+			subMeshRender.SubmitSubMesh(subMesh, format);
 		}
 	}
 
-	void MeshRenderer::Draw()
+	void MeshRenderer::Submit(const glm::mat4& model, int32_t entityID) const
 	{
+		const auto& materials = m_Mesh->GetMaterials();
 		for (size_t i = 0; i < m_SubMeshRenderers.size(); i++)
 		{
-			auto& materials = m_Mesh->GetMaterials();
 			const auto materialIndex = m_Mesh->GetSubMeshes()[i].GetMaterialIndex();
-			if (materials.size() > materialIndex)
-				materials[materialIndex]->bind(0);
-			else
-			{
-				auto whiteTexture = AssetsManager::Load<Texture2D>("resources/textures/white.jpg", AssetsManager::LoadType::Editor);
-				whiteTexture->bind(0);
-			}
-			m_SubMeshRenderers[i].Draw();
+			const Texture2D* texture = materials.size() > materialIndex ? materials[materialIndex].get() : nullptr;
+			m_SubMeshRenderers[i].Submit(model, texture, entityID);
 		}
 	}
 }
\ No newline at end of file
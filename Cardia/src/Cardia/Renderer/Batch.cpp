@@ -1,28 +1,61 @@
 ﻿#include "cdpch.hpp"
 #include "Cardia/Renderer/Batch.hpp"
 
-#include <numeric>
-#include <Cardia/Project/AssetsManager.hpp>
+#include <cstring>
 
 #include "Cardia/Renderer/RenderAPI.hpp"
+#include "Cardia/DataStructure/RadixSort.hpp"
 
 
 namespace Cardia
 {
-	Batch::Batch(VertexArray* va, const glm::vec3& cameraPosition, const Texture2D* texture, const BatchSpecification& specification) :
-		specification(specification), camPos(cameraPosition), m_CurrentTexture(texture)
+	// Shared by every batch, only used while rendering
+	static std::vector<SortItem> s_SortItems;
+	static std::vector<SortItem> s_SortScratch;
+
+	SpriteInstance MakeSpriteInstance(const glm::mat4& transform, const glm::vec4& color, const glm::vec4& uvRect, float tilingFactor, int32_t entityID)
+	{
+		const glm::mat4 rows = glm::transpose(transform);
+
+		SpriteInstance sprite {};
+		sprite.transformRows[0] = rows[0];
+		sprite.transformRows[1] = rows[1];
+		sprite.transformRows[2] = rows[2];
+		sprite.color = color;
+		sprite.uvRect = uvRect;
+		sprite.tilingFactor = tilingFactor;
+		sprite.entityID = entityID;
+		return sprite;
+	}
+
+	BatchSpecification MakeSpriteSpecification(const Texture2D* texture, const glm::vec4& color, int32_t zIndex, bool instanced)
+	{
+		BatchSpecification specification;
+		specification.alpha = color.a < 1.0f;
+		specification.layer = zIndex;
+		specification.shaderFeatures = ShaderFeature::Lit;
+		if (texture)
+			specification.shaderFeatures |= ShaderFeature::Textured;
+		if (color.a == 0.0f || (texture && texture->isTransparent()))
+			specification.shaderFeatures |= ShaderFeature::AlphaTested;
+		if (instanced)
+			specification.shaderFeatures |= ShaderFeature::Instanced;
+		return specification;
+	}
+
+	Batch::Batch(VertexArray* va, const glm::vec3& cameraPosition, const Texture2D* whiteTexture, const BatchSpecification& specification) :
+		specification(specification), camPos(cameraPosition)
 	{
 		vertexArray = va;
 
 		vertexBuffer = &va->getVertexBuffer();
 		indexBuffer = &va->getIndexBuffer();
+		if (specification.isInstanced())
+			instanceBuffer = &va->getInstanceBuffer();
 		indexOffset = 0;
 
-		const auto shaderPath = "resources/shaders/" + specification.shader;
-		m_Shader = AssetsManager::Load<Shader>(shaderPath);
-
-		uint32_t whiteColor = 0xffffffff;
-		whiteTexture = Texture2D::create(1, 1, &whiteColor);
+		m_TextureSlots[0] = whiteTexture;
+		m_MaxTextureSlots = std::min(maxTextureSlots, RenderAPI::get().getMaxTextureSlots());
 		startBash();
 	}
 
@@ -32,54 +65,186 @@ namespace Cardia
 		indexOffset = 0;
 		vertexBufferData.clear();
 		indexBufferData.clear();
+		instanceBufferData.clear();
+	}
+
+	void Batch::prepare(BatchOrder order, const SpriteCulling* culling)
+	{
+		if (specification.isInstanced())
+			prepareInstances(order, culling);
+		else
+			prepareMeshes(order);
+	}
+
+	void Batch::draw(Shader& shader) const
+	{
+		if (m_Culling)
+		{
+			m_Culling->vertexArray->bind();
+			bindShaderAndTextures(shader);
+			RenderAPI::get().multiDrawIndexedIndirect(m_Culling->vertexArray, *m_Culling->commands, 1, m_Culling->commandSlot);
+			return;
+		}
+
+		vertexArray->bind();
+		bindShaderAndTextures(shader);
+		if (specification.isInstanced())
+			RenderAPI::get().drawIndexedInstanced(vertexArray, static_cast<uint32_t>(instanceBufferData.size()), m_FirstInstance);
+		else
+			RenderAPI::get().drawIndexed(vertexArray, indexCount, m_FirstIndex, m_BaseVertex);
+	}
+
+	uint64_t Batch::drawKey(bool frontToBack) const
+	{
+		if (!frontToBack || specification.alpha)
+			return specification.key();
+
+		// Squared distances are positive, their top 23 bits after the sign keep their order
+		const uint64_t depth = (FloatSortKey(m_NearestDistance) & 0x7fffffffu) >> 8;
+		return specification.key() | depth << 8;
+	}
+
+	uint32_t Batch::getTriangleCount() const
+	{
+		if (specification.isInstanced())
+			return static_cast<uint32_t>(instanceBufferData.size()) * 2;
+		return indexCount / 3;
 	}
 
-	void Batch::render(bool alpha)
+	uint64_t Batch::orderKey(const glm::vec3& position, BatchOrder order) const
 	{
-		if (alpha)
+		const glm::vec3 toCamera = position - camPos;
+		const uint32_t distanceKey = FloatSortKey(glm::dot(toCamera, toCamera));
+		return order == BatchOrder::FrontToBack ? distanceKey : ~distanceKey;
+	}
+
+	void Batch::bindShaderAndTextures(Shader& shader) const
+	{
+		shader.bind();
+		for (int32_t slot = 0; slot < m_TextureSlotCount; ++slot)
+			m_TextureSlots[slot]->bind(slot);
+	}
+
+	void Batch::prepareMeshes(BatchOrder order)
+	{
+		s_SortItems.clear();
+		for (uint32_t object = 0; object < indexBufferData.size(); ++object)
 		{
-			std::ranges::sort(indexBufferData, [this](const std::vector<uint32_t>& a, const std::vector<uint32_t>& b)
+			uint64_t key = object;
+			if (order != BatchOrder::Submission)
 			{
-				const auto lambda = [this](const glm::vec3 va, const uint32_t ib)
-				{
-					return va + vertexBufferData[ib].position;
-				};
-				const auto vertexA = std::accumulate(a.begin(), a.end(), glm::vec3(0), lambda) / 3.0f;
-				const auto vertexB = std::accumulate(b.begin(), b.end(), glm::vec3(0), lambda) / 3.0f;
-				return glm::distance(vertexA, camPos) >= glm::distance(vertexB, camPos);
-			});
+				glm::vec3 centroid {};
+				for (const auto index : indexBufferData[object])
+					centroid += vertexBufferData[index].position;
+				centroid /= static_cast<float>(indexBufferData[object].size());
+				key = orderKey(centroid, order);
+			}
+			s_SortItems.push_back({ key, object });
 		}
+		if (order != BatchOrder::Submission)
+			RadixSort(s_SortItems, s_SortScratch);
 
-		std::vector<uint32_t> iboData;
+		uint32_t vertexByteOffset {};
+		void* vertices = vertexBuffer->map(static_cast<uint32_t>(vertexBufferData.size() * sizeof(Vertex)), sizeof(Vertex), vertexByteOffset);
+		std::memcpy(vertices, vertexBufferData.data(), vertexBufferData.size() * sizeof(Vertex));
 
-		for (const auto& object: indexBufferData)
+		uint32_t indexByteOffset {};
+		auto* indices = static_cast<uint32_t*>(indexBuffer->map(indexCount * sizeof(uint32_t), sizeof(uint32_t), indexByteOffset));
+		for (const auto& item: s_SortItems)
 		{
-			iboData.reserve(object.size());
-			iboData.insert(iboData.end(), object.begin(), object.end());
+			indices = std::ranges::copy(indexBufferData[item.index], indices).out;
 		}
-		vertexArray->bind();
 
-		vertexBuffer->setData(vertexBufferData.data(), static_cast<int>(vertexBufferData.size()) * sizeof(Vertex));
-		indexBuffer->setData(iboData.data(), static_cast<int>(iboData.size()) * sizeof(uint32_t));
+		m_FirstIndex = indexByteOffset / sizeof(uint32_t);
+		m_BaseVertex = static_cast<int32_t>(vertexByteOffset / sizeof(Vertex));
+	}
+
+	void Batch::prepareInstances(BatchOrder order, const SpriteCulling* culling)
+	{
+		const auto instanceCount = static_cast<uint32_t>(instanceBufferData.size());
+		uint32_t instanceByteOffset {};
+		auto* instances = static_cast<SpriteInstance*>(instanceBuffer->map(instanceCount * sizeof(SpriteInstance), sizeof(SpriteInstance), instanceByteOffset));
 
-		m_Shader->bind();
-		m_Shader->setInt("u_Texture", 0);
-		m_Shader->setMat4("u_Model", glm::mat4(1));
-		if (m_CurrentTexture)
-			m_CurrentTexture->bind(0);
+		if (order == BatchOrder::Submission)
+		{
+			std::memcpy(instances, instanceBufferData.data(), instanceCount * sizeof(SpriteInstance));
+		}
 		else
-			whiteTexture->bind(0);
+		{
+			// Keys are computed once per sprite, the sorted order is gathered straight into the mapped buffer
+			s_SortItems.clear();
+			for (uint32_t index = 0; index < instanceCount; ++index)
+			{
+				const auto& rows = instanceBufferData[index].transformRows;
+				s_SortItems.push_back({ orderKey({ rows[0].w, rows[1].w, rows[2].w }, order), index });
+			}
+			RadixSort(s_SortItems, s_SortScratch);
+
+			for (const auto& item : s_SortItems)
+				*instances++ = instanceBufferData[item.index];
+		}
+
+		m_FirstInstance = instanceByteOffset / sizeof(SpriteInstance);
+		m_Culling.reset();
+		if (culling)
+		{
+			auto& computeShader = *culling->computeShader;
+			computeShader.bind();
+			computeShader.setInt("u_FirstInstance", static_cast<int>(m_FirstInstance));
+			computeShader.setInt("u_InstanceCount", static_cast<int>(instanceCount));
+			computeShader.setInt("u_IndexCount", vertexArray->getIndexBuffer().getCount());
+			computeShader.setInt("u_CommandSlot", static_cast<int>(culling->commandSlot));
+			instanceBuffer->bindStorage(2);
+			culling->vertexArray->getInstanceBuffer().bindStorage(3);
+			culling->commands->bindStorage(4);
+			culling->groupCounts->bindStorage(5);
+
+			// Counted then compacted, an empty batch still gets one workgroup to write its command
+			const uint32_t groupCount = std::max(1u, (instanceCount + spriteCullGroupSize - 1) / spriteCullGroupSize);
+			for (int pass = 0; pass < 2; ++pass)
+			{
+				computeShader.setInt("u_Pass", pass);
+				RenderAPI::get().dispatchCompute(groupCount);
+				RenderAPI::get().computeBarrier();
+			}
+			m_Culling = *culling;
+		}
+	}
+
+	int32_t Batch::getTextureSlot(const Texture2D* texture)
+	{
+		if (!texture)
+			return 0;
+
+		for (int32_t slot = 1; slot < m_TextureSlotCount; ++slot)
+		{
+			if (*m_TextureSlots[slot] == *texture)
+				return slot;
+		}
+
+		if (m_TextureSlotCount >= m_MaxTextureSlots)
+			return -1;
 
-		RenderAPI::get().drawIndexed(vertexArray, indexCount);
+		m_TextureSlots[m_TextureSlotCount] = texture;
+		return m_TextureSlotCount++;
 	}
 
-	bool Batch::addMesh(SubMesh* mesh)
+	bool Batch::addMesh(SubMesh* mesh, const Texture2D* texture)
 	{
-		if (indexCount >= maxIndices)
+		if (indexCount + mesh->GetIndices().size() > maxIndices || vertexBufferData.size() + mesh->GetVertices().size() > maxVertices)
 			return false;
 
+		const int32_t textureSlot = getTextureSlot(texture);
+		if (textureSlot < 0)
+			return false;
+
+		const auto firstVertex = vertexBufferData.size();
 		vertexBufferData.reserve( vertexBufferData.size() + mesh->GetVertices().size() );
 		vertexBufferData.insert(vertexBufferData.end(), mesh->GetVertices().begin(), mesh->GetVertices().end());
+		for (auto vertex = vertexBufferData.begin() + firstVertex; vertex != vertexBufferData.end(); ++vertex)
+		{
+			vertex->textureIndex = textureSlot;
+		}
 
 		std::vector<uint32_t>& indices = indexBufferData.emplace_back(mesh->GetIndices().begin(), mesh->GetIndices().end());
 		for (auto& index: indices)
@@ -90,6 +255,30 @@ namespace Cardia
 		indexOffset += mesh->GetVertices().size();
 		indexCount += indices.size();
 
+		for (auto vertex = vertexBufferData.begin() + firstVertex; vertex != vertexBufferData.end(); ++vertex)
+		{
+			const glm::vec3 toCamera = vertex->position - camPos;
+			m_NearestDistance = std::min(m_NearestDistance, glm::dot(toCamera, toCamera));
+		}
+
+		return true;
+	}
+
+	bool Batch::addSprite(const SpriteInstance& sprite, const Texture2D* texture)
+	{
+		if (instanceBufferData.size() >= maxSpriteInstances)
+			return false;
+
+		const int32_t textureSlot = getTextureSlot(texture);
+		if (textureSlot < 0)
+			return false;
+
+		auto& instance = instanceBufferData.emplace_back(sprite);
+		instance.textureIndex = textureSlot;
+
+		const auto& rows = sprite.transformRows;
+		const glm::vec3 toCamera = glm::vec3(rows[0].w, rows[1].w, rows[2].w) - camPos;
+		m_NearestDistance = std::min(m_NearestDistance, glm::dot(toCamera, toCamera));
 		return true;
 	}
 }
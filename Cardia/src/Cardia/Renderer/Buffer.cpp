@@ -3,20 +3,19 @@
 #include "Cardia/Renderer/Renderer.hpp"
 #include "Cardia/Core/Log.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLBuffer.hpp"
+#include "Cardia/Renderer/Null/NullBuffer.hpp"
 
 
 namespace Cardia
 {
 
-	std::unique_ptr<VertexBuffer> VertexBuffer::create(Vertex* vertices, uint32_t size)
+	std::unique_ptr<VertexBuffer> VertexBuffer::create(const void* vertices, uint32_t size)
 	{
 		RenderAPI::API& renderer = Renderer::getAPI();
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
-				Log::coreError("{0} is not supported for the moment !", renderer);
-				cdCoreAssert(false, "Invalid API provided");
-				return nullptr;
+				return std::make_unique<NullVertexBuffer>(vertices, size);
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLVertexBuffer>(vertices, size);
 			default:
@@ -32,9 +31,7 @@ namespace Cardia
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
-				Log::coreError("{0} is not supported for the moment !", renderer);
-				cdCoreAssert(false, "Invalid API provided");
-				return nullptr;
+				return std::make_unique<NullVertexBuffer>(size);
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLVertexBuffer>(size);
 			default:
@@ -44,15 +41,29 @@ namespace Cardia
 		}
 	}
 
-	std::unique_ptr<IndexBuffer> IndexBuffer::create(uint32_t *indices, uint32_t count)
+	std::unique_ptr<VertexBuffer> VertexBuffer::createStreaming(uint32_t regionSize)
 	{
 		RenderAPI::API& renderer = Renderer::getAPI();
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
+				return std::make_unique<NullVertexBuffer>(regionSize, true);
+			case RenderAPI::API::OpenGL:
+				return std::make_unique<OpenGLVertexBuffer>(regionSize, true);
+			default:
 				Log::coreError("{0} is not supported for the moment !", renderer);
 				cdCoreAssert(false, "Invalid API provided");
 				return nullptr;
+		}
+	}
+
+	std::unique_ptr<IndexBuffer> IndexBuffer::create(uint32_t *indices, uint32_t count)
+	{
+		RenderAPI::API& renderer = Renderer::getAPI();
+		switch (renderer)
+		{
+			case RenderAPI::API::None:
+				return std::make_unique<NullIndexBuffer>(indices, count);
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLIndexBuffer>(indices, count);
 			default:
@@ -68,9 +79,7 @@ namespace Cardia
 		switch (renderer)
 		{
 		case RenderAPI::API::None:
-			Log::coreError("{0} is not supported for the moment !", renderer);
-			cdCoreAssert(false, "Invalid API provided");
-			return nullptr;
+			return std::make_unique<NullIndexBuffer>(count);
 		case RenderAPI::API::OpenGL:
 			return std::make_unique<OpenGLIndexBuffer>(count);
 		default:
@@ -80,15 +89,29 @@ namespace Cardia
 		}
 	}
 
-	std::unique_ptr<StorageBuffer> StorageBuffer::create(uint32_t size)
+	std::unique_ptr<IndexBuffer> IndexBuffer::createStreaming(uint32_t indexCount)
 	{
 		RenderAPI::API& renderer = Renderer::getAPI();
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
+				return std::make_unique<NullIndexBuffer>(indexCount, true);
+			case RenderAPI::API::OpenGL:
+				return std::make_unique<OpenGLIndexBuffer>(indexCount, true);
+			default:
 				Log::coreError("{0} is not supported for the moment !", renderer);
 				cdCoreAssert(false, "Invalid API provided");
 				return nullptr;
+		}
+	}
+
+	std::unique_ptr<StorageBuffer> StorageBuffer::create(uint32_t size)
+	{
+		RenderAPI::API& renderer = Renderer::getAPI();
+		switch (renderer)
+		{
+			case RenderAPI::API::None:
+				return std::make_unique<NullStorageBuffer>(size);
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLStorageBuffer>(size);
 			default:
@@ -104,15 +127,74 @@ namespace Cardia
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
+				return std::make_unique<NullStorageBuffer>(data, size);
+			case RenderAPI::API::OpenGL:
+				return std::make_unique<OpenGLStorageBuffer>(data, size);
+			default:
 				Log::coreError("{0} is not supported for the moment !", renderer);
 				cdCoreAssert(false, "Invalid API provided");
 				return nullptr;
+		}
+	}
+
+	std::unique_ptr<UniformBuffer> UniformBuffer::create(uint32_t size)
+	{
+		RenderAPI::API& renderer = Renderer::getAPI();
+		switch (renderer)
+		{
+			case RenderAPI::API::None:
+				return std::make_unique<NullUniformBuffer>(size);
 			case RenderAPI::API::OpenGL:
-				return std::make_unique<OpenGLStorageBuffer>(data, size);
+				return std::make_unique<OpenGLUniformBuffer>(size);
+			default:
+				Log::coreError("{0} is not supported for the moment !", renderer);
+				cdCoreAssert(false, "Invalid API provided");
+				return nullptr;
+		}
+	}
+
+	std::unique_ptr<IndirectBuffer> IndirectBuffer::create(uint32_t size)
+	{
+		RenderAPI::API& renderer = Renderer::getAPI();
+		switch (renderer)
+		{
+			case RenderAPI::API::None:
+				return std::make_unique<NullIndirectBuffer>(size);
+			case RenderAPI::API::OpenGL:
+				return std::make_unique<OpenGLIndirectBuffer>(size);
 			default:
 				Log::coreError("{0} is not supported for the moment !", renderer);
 				cdCoreAssert(false, "Invalid API provided");
 				return nullptr;
 		}
 	}
+
+	BufferLayout GetVertexLayout(VertexFormat format)
+	{
+		switch (format)
+		{
+			case VertexFormat::Packed:
+				static_assert(sizeof(PackedVertex) == 36, "PackedVertex must match its buffer layout");
+				return {
+					{ShaderDataType::Float3, "a_Position"},
+					{ShaderDataType::Short4, "a_Normal", true},
+					{ShaderDataType::UByte4, "a_Color", true},
+					{ShaderDataType::Half2, "a_TexPos"},
+					{ShaderDataType::Half, "a_TilingFactor"},
+					{ShaderDataType::UShort, "a_TextureIndex"},
+					{ShaderDataType::Int, "a_EntityID"}
+				};
+			case VertexFormat::Standard:
+			default:
+				return {
+					{ShaderDataType::Float3, "a_Position"},
+					{ShaderDataType::Float3, "a_Normal"},
+					{ShaderDataType::Float4, "a_Color"},
+					{ShaderDataType::Float2, "a_TexPos"},
+					{ShaderDataType::Float, "a_TilingFactor"},
+					{ShaderDataType::Int, "a_TextureIndex"},
+					{ShaderDataType::Int, "a_EntityID"}
+				};
+		}
+	}
 }
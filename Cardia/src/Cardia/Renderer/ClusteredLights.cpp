@@ -0,0 +1,171 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/ClusteredLights.hpp"
+
+#include "Cardia/ECS/Components.hpp"
+
+
+namespace Cardia
+{
+	constexpr int lightBinding = 0;
+	constexpr int clusterBinding = 6;
+	constexpr int lightIndexBinding = 7;
+	constexpr uint32_t minimumCapacity = 64;
+
+	ClusteredLights::ClusteredLights()
+	{
+		m_Clusters.resize(clusterCount);
+		m_ClusterSizes.resize(clusterCount);
+		m_ClusterBuffer = StorageBuffer::create(clusterCount * sizeof(glm::uvec2));
+		m_LightCapacity = minimumCapacity;
+		m_LightBuffer = StorageBuffer::create(m_LightCapacity * sizeof(LightData));
+		m_LightIndexCapacity = minimumCapacity;
+		m_LightIndexBuffer = StorageBuffer::create(m_LightIndexCapacity * sizeof(uint32_t));
+	}
+
+	uint32_t ClusteredLights::depthSlice(float viewDepth) const
+	{
+		const float depth = m_DepthParameters.z > 0.5f ? std::log(std::max(viewDepth, 1e-4f)) : viewDepth;
+		const float slice = depth * m_DepthParameters.x - m_DepthParameters.y;
+		return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(clusterGridZ - 1)));
+	}
+
+	bool ClusteredLights::clusterRange(const LightData& light, const glm::mat4& view, const glm::mat4& projection, ClusterRange& range) const
+	{
+		const float radius = light.directionAndRange.w;
+		const glm::vec3 center = view * glm::vec4(glm::vec3(light.positionAndType), 1.0f);
+		const float nearDepth = -center.z - radius;
+		const float farDepth = -center.z + radius;
+		if (farDepth < m_Near || nearDepth > m_Far)
+			return false;
+
+		// Screen bounds of the view space box around the light sphere
+		glm::vec2 ndcMin { 1.0f };
+		glm::vec2 ndcMax { -1.0f };
+		bool crossesCamera = false;
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const glm::vec3 offset {
+				corner & 1 ? radius : -radius,
+				corner & 2 ? radius : -radius,
+				corner & 4 ? radius : -radius
+			};
+			const glm::vec4 clip = projection * glm::vec4(center + offset, 1.0f);
+			if (clip.w <= 1e-4f)
+			{
+				crossesCamera = true;
+				break;
+			}
+			const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+			ndcMin = glm::min(ndcMin, ndc);
+			ndcMax = glm::max(ndcMax, ndc);
+		}
+		if (crossesCamera)
+		{
+			ndcMin = glm::vec2(-1.0f);
+			ndcMax = glm::vec2(1.0f);
+		}
+		if (ndcMax.x < -1.0f || ndcMax.y < -1.0f || ndcMin.x > 1.0f || ndcMin.y > 1.0f)
+			return false;
+
+		const glm::vec2 grid { clusterGridX, clusterGridY };
+		const glm::vec2 tileMin = glm::clamp((ndcMin * 0.5f + 0.5f) * grid, glm::vec2(0.0f), grid - 1.0f);
+		const glm::vec2 tileMax = glm::clamp((ndcMax * 0.5f + 0.5f) * grid, glm::vec2(0.0f), grid - 1.0f);
+		range.min = glm::uvec3(glm::uvec2(tileMin), depthSlice(std::max(nearDepth, m_Near)));
+		range.max = glm::uvec3(glm::uvec2(tileMax), depthSlice(std::min(farDepth, m_Far)));
+		return true;
+	}
+
+	void ClusteredLights::update(const std::vector<LightData>& lights, const glm::mat4& view, const glm::mat4& projection)
+	{
+		// Depth range of the projection, slices are logarithmic in perspective and linear in orthographic
+		const bool perspective = projection[2][3] != 0.0f;
+		if (perspective)
+		{
+			m_Near = projection[3][2] / (projection[2][2] - 1.0f);
+			m_Far = projection[3][2] / (projection[2][2] + 1.0f);
+			const float scale = static_cast<float>(clusterGridZ) / std::log(m_Far / m_Near);
+			m_DepthParameters = { scale, std::log(m_Near) * scale, 1.0f, 0.0f };
+		}
+		else
+		{
+			m_Near = (projection[3][2] + 1.0f) / projection[2][2];
+			m_Far = (projection[3][2] - 1.0f) / projection[2][2];
+			const float scale = static_cast<float>(clusterGridZ) / (m_Far - m_Near);
+			m_DepthParameters = { scale, m_Near * scale, 0.0f, 0.0f };
+		}
+
+		m_Lights.clear();
+		std::ranges::copy_if(lights, std::back_inserter(m_Lights), [](const LightData& light)
+		{
+			return static_cast<int32_t>(light.positionAndType.w) == Component::LightType::DirectionalLight;
+		});
+		m_DirectionalLightCount = static_cast<uint32_t>(m_Lights.size());
+		std::ranges::copy_if(lights, std::back_inserter(m_Lights), [](const LightData& light)
+		{
+			return static_cast<int32_t>(light.positionAndType.w) != Component::LightType::DirectionalLight;
+		});
+
+		// Counting pass, then offsets, then fill: the index list stays tightly packed per cluster
+		std::ranges::fill(m_ClusterSizes, 0);
+		m_Ranges.resize(m_Lights.size());
+		for (uint32_t index = m_DirectionalLightCount; index < m_Lights.size(); ++index)
+		{
+			auto& range = m_Ranges[index];
+			if (!clusterRange(m_Lights[index], view, projection, range))
+			{
+				range.min = glm::uvec3(1);
+				range.max = glm::uvec3(0);
+				continue;
+			}
+			for (uint32_t z = range.min.z; z <= range.max.z; ++z)
+				for (uint32_t y = range.min.y; y <= range.max.y; ++y)
+					for (uint32_t x = range.min.x; x <= range.max.x; ++x)
+						m_ClusterSizes[(z * clusterGridY + y) * clusterGridX + x]++;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t cluster = 0; cluster < clusterCount; ++cluster)
+		{
+			m_ClusterSizes[cluster] = std::min(m_ClusterSizes[cluster], maxLightsPerCluster);
+			m_Clusters[cluster] = { offset, 0 };
+			offset += m_ClusterSizes[cluster];
+		}
+
+		m_LightIndices.resize(offset);
+		for (uint32_t index = m_DirectionalLightCount; index < m_Lights.size(); ++index)
+		{
+			const auto& range = m_Ranges[index];
+			for (uint32_t z = range.min.z; z <= range.max.z; ++z)
+				for (uint32_t y = range.min.y; y <= range.max.y; ++y)
+					for (uint32_t x = range.min.x; x <= range.max.x; ++x)
+					{
+						const uint32_t clusterIndex = (z * clusterGridY + y) * clusterGridX + x;
+						auto& cluster = m_Clusters[clusterIndex];
+						if (cluster.y < m_ClusterSizes[clusterIndex])
+							m_LightIndices[cluster.x + cluster.y++] = index;
+					}
+		}
+
+		if (m_Lights.size() > m_LightCapacity)
+		{
+			m_LightCapacity = std::max(static_cast<uint32_t>(m_Lights.size()), m_LightCapacity * 2);
+			m_LightBuffer = StorageBuffer::create(m_LightCapacity * sizeof(LightData));
+		}
+		if (m_LightIndices.size() > m_LightIndexCapacity)
+		{
+			m_LightIndexCapacity = std::max(static_cast<uint32_t>(m_LightIndices.size()), m_LightIndexCapacity * 2);
+			m_LightIndexBuffer = StorageBuffer::create(m_LightIndexCapacity * sizeof(uint32_t));
+		}
+
+		m_LightBuffer->setData(m_Lights.data(), m_Lights.size() * sizeof(LightData));
+		m_ClusterBuffer->setData(m_Clusters.data(), clusterCount * sizeof(glm::uvec2));
+		m_LightIndexBuffer->setData(m_LightIndices.data(), m_LightIndices.size() * sizeof(uint32_t));
+	}
+
+	void ClusteredLights::bind() const
+	{
+		m_LightBuffer->bind(lightBinding);
+		m_ClusterBuffer->bind(clusterBinding);
+		m_LightIndexBuffer->bind(lightIndexBinding);
+	}
+}
@@ -2,6 +2,7 @@
 #include "Cardia/Renderer/Framebuffer.hpp"
 #include "Cardia/Renderer/Renderer.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLFramebuffer.hpp"
+#include "Cardia/Renderer/Null/NullFramebuffer.hpp"
 
 
 namespace Cardia
@@ -13,9 +14,7 @@ namespace Cardia
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
-				Log::coreError("{0} is not supported for the moment !", renderer);
-				cdCoreAssert(false, "Invalid API provided");
-				return nullptr;
+				return std::make_unique<NullFramebuffer>(spec);
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLFramebuffer>(spec);
 			default:
@@ -0,0 +1,32 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/GpuProfiler.hpp"
+#include "Cardia/Renderer/RenderAPI.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLGpuProfiler.hpp"
+#include "Cardia/Renderer/Null/NullGpuProfiler.hpp"
+
+
+namespace Cardia
+{
+	void GpuProfiler::init()
+	{
+		const RenderAPI::API api = RenderAPI::getAPI();
+		switch (api)
+		{
+		case RenderAPI::API::None:
+			s_Instance = std::make_unique<NullGpuProfiler>();
+			break;
+		case RenderAPI::API::OpenGL:
+			s_Instance = std::make_unique<OpenGLGpuProfiler>();
+			break;
+		default:
+			Log::coreError("{0} is not supported for the moment !", api);
+			cdCoreAssert(false, "Invalid API provided");
+			break;
+		}
+	}
+
+	void GpuProfiler::quit()
+	{
+		s_Instance.reset();
+	}
+}
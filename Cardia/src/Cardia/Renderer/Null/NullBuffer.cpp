@@ -0,0 +1,237 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullBuffer.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+#include "Cardia/Core/Core.hpp"
+
+
+namespace Cardia
+{
+	// Streaming Ring
+
+	void NullStreamingRing::create(uint32_t regionSize)
+	{
+		m_RegionSize = regionSize;
+		m_Data.resize(static_cast<size_t>(regionSize) * streamingBufferRegions);
+	}
+
+	void* NullStreamingRing::map(uint32_t size, uint32_t alignment, uint32_t& offset)
+	{
+		cdCoreAssert(size <= m_RegionSize, "Streaming allocation is bigger than a whole region");
+
+		const uint32_t regionStart = m_Region * m_RegionSize;
+		uint32_t start = regionStart + m_Cursor;
+		if (alignment > 1)
+			start = (start + alignment - 1) / alignment * alignment;
+
+		if (start + size > regionStart + m_RegionSize)
+		{
+			advance();
+			return map(size, alignment, offset);
+		}
+
+		// Written by the caller right after, counted as uploaded
+		NullRecorder::upload(size);
+		m_Unfenced[m_Region] = true;
+		m_Cursor = start + size - regionStart;
+		offset = start;
+		return m_Data.data() + start;
+	}
+
+	void NullStreamingRing::fence()
+	{
+		m_Unfenced.fill(false);
+	}
+
+	void NullStreamingRing::nextFrame()
+	{
+		fence();
+		advance();
+	}
+
+	void NullStreamingRing::advance()
+	{
+		const uint32_t next = (m_Region + 1) % streamingBufferRegions;
+		cdCoreAssert(!m_Unfenced[next], "Streaming uploads wrapped around onto a region that is not drawn yet");
+		m_Region = next;
+		m_Cursor = 0;
+	}
+
+	// Vertex Buffer
+
+	NullVertexBuffer::NullVertexBuffer(uint32_t size, bool streaming)
+		: m_Streaming(streaming)
+	{
+		NullRecorder::createObject();
+		if (m_Streaming)
+			m_Ring.create(size);
+	}
+
+	NullVertexBuffer::NullVertexBuffer(const void* vertices, uint32_t size)
+	{
+		NullRecorder::createObject();
+		NullRecorder::upload(size);
+	}
+
+	void NullVertexBuffer::bind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullVertexBuffer::unbind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullVertexBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		cdCoreAssert(!m_Streaming, "Streaming buffers are immutable, write through map() instead");
+		NullRecorder::upload(size);
+	}
+
+	void NullVertexBuffer::bindStorage(int index) const
+	{
+		NullRecorder::call();
+	}
+
+	void* NullVertexBuffer::map(uint32_t size, uint32_t alignment, uint32_t& offset)
+	{
+		cdCoreAssert(m_Streaming, "Only streaming buffers can be mapped");
+		return m_Ring.map(size, alignment, offset);
+	}
+
+	void NullVertexBuffer::fence()
+	{
+		if (m_Streaming)
+			m_Ring.fence();
+	}
+
+	void NullVertexBuffer::nextFrame()
+	{
+		if (m_Streaming)
+			m_Ring.nextFrame();
+	}
+
+	// Index Buffer
+
+	NullIndexBuffer::NullIndexBuffer(uint32_t count, bool streaming)
+		: m_Count(count), m_Streaming(streaming)
+	{
+		NullRecorder::createObject();
+		if (m_Streaming)
+			m_Ring.create(count * sizeof(uint32_t));
+	}
+
+	NullIndexBuffer::NullIndexBuffer(const uint32_t* indices, uint32_t count)
+		: m_Count(count)
+	{
+		NullRecorder::createObject();
+		NullRecorder::upload(count * sizeof(uint32_t));
+	}
+
+	void NullIndexBuffer::bind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullIndexBuffer::unbind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullIndexBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		cdCoreAssert(!m_Streaming, "Streaming buffers are immutable, write through map() instead");
+		NullRecorder::upload(size);
+	}
+
+	void* NullIndexBuffer::map(uint32_t size, uint32_t alignment, uint32_t& offset)
+	{
+		cdCoreAssert(m_Streaming, "Only streaming buffers can be mapped");
+		return m_Ring.map(size, alignment, offset);
+	}
+
+	void NullIndexBuffer::fence()
+	{
+		if (m_Streaming)
+			m_Ring.fence();
+	}
+
+	void NullIndexBuffer::nextFrame()
+	{
+		if (m_Streaming)
+			m_Ring.nextFrame();
+	}
+
+	// Storage Buffer
+
+	NullStorageBuffer::NullStorageBuffer(uint32_t size)
+	{
+		NullRecorder::createObject();
+	}
+
+	NullStorageBuffer::NullStorageBuffer(const void* data, uint32_t size)
+	{
+		NullRecorder::createObject();
+		NullRecorder::upload(size);
+	}
+
+	void NullStorageBuffer::bind(int index) const
+	{
+		NullRecorder::call();
+	}
+
+	void NullStorageBuffer::unbind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullStorageBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		NullRecorder::upload(size);
+	}
+
+	// Uniform Buffer
+
+	NullUniformBuffer::NullUniformBuffer(uint32_t size)
+	{
+		NullRecorder::createObject();
+	}
+
+	void NullUniformBuffer::bind(int index) const
+	{
+		NullRecorder::call();
+	}
+
+	void NullUniformBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		NullRecorder::upload(size);
+	}
+
+	// Indirect Buffer
+
+	NullIndirectBuffer::NullIndirectBuffer(uint32_t size)
+		: m_Size(size)
+	{
+		NullRecorder::createObject();
+	}
+
+	void NullIndirectBuffer::bind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullIndirectBuffer::unbind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullIndirectBuffer::bindStorage(int index) const
+	{
+		NullRecorder::call();
+	}
+
+	void NullIndirectBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		NullRecorder::upload(size);
+	}
+}
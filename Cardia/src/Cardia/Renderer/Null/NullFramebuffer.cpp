@@ -0,0 +1,61 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullFramebuffer.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+
+
+namespace Cardia
+{
+	NullFramebuffer::NullFramebuffer(FramebufferSpec spec)
+		: m_Spec(std::move(spec))
+	{
+		for (const auto& attachment : m_Spec.attachments.Attachments)
+		{
+			if (attachment.TextureFormat != FramebufferTextureFormat::DEPTH24STENCIL8)
+				m_ColorAttachments.push_back(NullRecorder::createObject());
+		}
+	}
+
+	void NullFramebuffer::Bind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullFramebuffer::Unbind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullFramebuffer::Resize(int width, int height)
+	{
+		m_Spec.width = width;
+		m_Spec.height = height;
+	}
+
+	int NullFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		NullRecorder::call();
+		return -1;
+	}
+
+	void NullFramebuffer::RequestPixels(uint32_t attachmentIndex, const PixelRegion& region)
+	{
+		NullRecorder::call();
+		m_PendingReads.push_back(region);
+	}
+
+	bool NullFramebuffer::PollPixels(PixelRegion& region, std::vector<int>& pixels)
+	{
+		if (m_PendingReads.empty())
+			return false;
+
+		region = m_PendingReads.front();
+		m_PendingReads.pop_front();
+		pixels.assign(static_cast<size_t>(region.width) * region.height, -1);
+		return true;
+	}
+
+	void NullFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+	{
+		NullRecorder::call();
+	}
+}
@@ -0,0 +1,59 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+
+#include <atomic>
+
+
+namespace Cardia
+{
+	namespace
+	{
+		std::atomic<uint64_t> s_Calls = 0;
+		std::atomic<uint64_t> s_DrawCalls = 0;
+		std::atomic<uint64_t> s_Dispatches = 0;
+		std::atomic<uint64_t> s_UploadedBytes = 0;
+		std::atomic<uint32_t> s_NextObject = 1;
+	}
+
+	void NullRecorder::call()
+	{
+		s_Calls.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void NullRecorder::draw()
+	{
+		call();
+		s_DrawCalls.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void NullRecorder::dispatch()
+	{
+		call();
+		s_Dispatches.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void NullRecorder::upload(uint64_t bytes)
+	{
+		call();
+		s_UploadedBytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	uint32_t NullRecorder::createObject()
+	{
+		call();
+		return s_NextObject.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	NullRenderCounters NullRecorder::getCounters()
+	{
+		return { s_Calls.load(), s_DrawCalls.load(), s_Dispatches.load(), s_UploadedBytes.load() };
+	}
+
+	void NullRecorder::resetCounters()
+	{
+		s_Calls = 0;
+		s_DrawCalls = 0;
+		s_Dispatches = 0;
+		s_UploadedBytes = 0;
+	}
+}
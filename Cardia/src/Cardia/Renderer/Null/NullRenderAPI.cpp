@@ -0,0 +1,123 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullRenderAPI.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+
+
+namespace Cardia
+{
+	// What GL 4.6 implementations commonly report, batches are sized after it
+	constexpr int nullMaxTextureSlots = 32;
+
+	void NullRenderAPI::setClearColor(const glm::vec4& color)
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderAPI::clear()
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderAPI::setViewPort(int x, int y, int w, int h)
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderAPI::setWireFrame(bool state)
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderAPI::clearDepthBuffer()
+	{
+		NullRecorder::call();
+	}
+
+	int NullRenderAPI::getMaxTextureSlots()
+	{
+		return nullMaxTextureSlots;
+	}
+
+	void NullRenderAPI::enableDepth()
+	{
+		NullRecorder::call();
+		m_StateChanges++;
+	}
+
+	void NullRenderAPI::disableDepth()
+	{
+		NullRecorder::call();
+		m_StateChanges++;
+	}
+
+	void NullRenderAPI::enableBlending()
+	{
+		NullRecorder::call();
+		m_StateChanges++;
+	}
+
+	void NullRenderAPI::disableBlending()
+	{
+		NullRecorder::call();
+		m_StateChanges++;
+	}
+
+	void NullRenderAPI::setDepthFunction(DepthFunction function)
+	{
+		NullRecorder::call();
+		m_StateChanges++;
+	}
+
+	void NullRenderAPI::setDepthWrite(bool state)
+	{
+		NullRecorder::call();
+		m_StateChanges++;
+	}
+
+	void NullRenderAPI::setColorWrite(bool state)
+	{
+		NullRecorder::call();
+		m_StateChanges++;
+	}
+
+	RenderAPI::StateCounters NullRenderAPI::getStateCounters()
+	{
+		// Nothing is cached, every change would reach the driver
+		return { m_StateChanges, 0 };
+	}
+
+	void NullRenderAPI::resetStateCounters()
+	{
+		m_StateChanges = 0;
+	}
+
+	void NullRenderAPI::drawIndexed(const VertexArray* vertexArray, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
+	{
+		NullRecorder::draw();
+	}
+
+	void NullRenderAPI::drawIndexedInstanced(const VertexArray* vertexArray, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		NullRecorder::draw();
+	}
+
+	void NullRenderAPI::multiDrawIndexedIndirect(const VertexArray* vertexArray, const IndirectBuffer& commands, uint32_t drawCount, uint32_t firstCommand)
+	{
+		NullRecorder::draw();
+	}
+
+	void NullRenderAPI::multiDrawIndexedIndirectCount(const VertexArray* vertexArray, const IndirectBuffer& commands, const IndirectBuffer& drawCounts, uint32_t countIndex, uint32_t maxDrawCount, uint32_t firstCommand)
+	{
+		NullRecorder::draw();
+	}
+
+	void NullRenderAPI::dispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		NullRecorder::dispatch();
+	}
+
+	void NullRenderAPI::computeBarrier()
+	{
+		NullRecorder::call();
+	}
+}
@@ -0,0 +1,49 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullRenderGraphBackend.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+
+
+namespace Cardia
+{
+	uint32_t NullRenderGraphBackend::acquireTexture(const RenderGraphTextureDesc& desc)
+	{
+		return NullRecorder::createObject();
+	}
+
+	void NullRenderGraphBackend::clearTexture(uint32_t texture, const RenderGraphTextureDesc& desc)
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderGraphBackend::beginPass(const std::vector<uint32_t>& colors, uint32_t depth, int width, int height)
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderGraphBackend::endPass()
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderGraphBackend::barrier(RenderGraphAccess access)
+	{
+		NullRecorder::call();
+	}
+
+	void NullRenderGraphBackend::requestPixels(uint32_t texture, const PixelRegion& region)
+	{
+		NullRecorder::call();
+		m_PendingReads.push_back(region);
+	}
+
+	bool NullRenderGraphBackend::pollPixels(PixelRegion& region, std::vector<int>& pixels)
+	{
+		if (m_PendingReads.empty())
+			return false;
+
+		region = m_PendingReads.front();
+		m_PendingReads.pop_front();
+		pixels.assign(static_cast<size_t>(region.width) * region.height, -1);
+		return true;
+	}
+}
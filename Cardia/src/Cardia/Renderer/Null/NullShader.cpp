@@ -0,0 +1,52 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullShader.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+
+
+namespace Cardia
+{
+	NullShader::NullShader()
+	{
+		NullRecorder::createObject();
+	}
+
+	void NullShader::bind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullShader::unbind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullShader::setFloat4(const std::string& name, const glm::vec4& value)
+	{
+		NullRecorder::call();
+	}
+
+	void NullShader::setFloat4Array(const std::string& name, const glm::vec4* values, int count)
+	{
+		NullRecorder::call();
+	}
+
+	void NullShader::setFloat3(const std::string& name, const glm::vec3& value)
+	{
+		NullRecorder::call();
+	}
+
+	void NullShader::setMat4(const std::string& name, const glm::mat4& value)
+	{
+		NullRecorder::call();
+	}
+
+	void NullShader::setInt(const std::string& name, int value)
+	{
+		NullRecorder::call();
+	}
+
+	void NullShader::setIntArray(const std::string& name, int* values, int count)
+	{
+		NullRecorder::call();
+	}
+}
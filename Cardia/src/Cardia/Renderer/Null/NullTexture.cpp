@@ -0,0 +1,57 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullTexture.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+#include "Cardia/Renderer/TextureData.hpp"
+#include "Cardia/Core/Core.hpp"
+
+#include <stb_image/stb_image.h>
+
+
+namespace Cardia
+{
+	NullTexture2D::NullTexture2D(std::string path)
+		: m_TextureID(NullRecorder::createObject())
+	{
+		m_Path = std::move(path);
+		if (IsTextureContainer(m_Path))
+		{
+			TextureData data;
+			m_Loaded = LoadTextureContainer(m_Path, data);
+			if (!m_Loaded)
+			{
+				Log::coreWarn("Invalid texture container");
+				return;
+			}
+			m_Width = static_cast<int32_t>(data.levels.front().width);
+			m_Height = static_cast<int32_t>(data.levels.front().height);
+			m_IsTransparent = TextureFormatHasAlpha(data.format);
+			NullRecorder::upload(data.bytes.size());
+			return;
+		}
+
+		int width, height, nbChannels;
+		m_Loaded = stbi_info(m_Path.c_str(), &width, &height, &nbChannels) != 0;
+		if (!m_Loaded)
+		{
+			Log::coreWarn("Invalid image");
+			return;
+		}
+
+		m_Width = width;
+		m_Height = height;
+		m_IsTransparent = nbChannels == 2 || nbChannels == 4;
+		NullRecorder::upload(static_cast<uint64_t>(width) * height * nbChannels);
+	}
+
+	NullTexture2D::NullTexture2D(int width, int height, void* data)
+		: m_Width(width), m_Height(height), m_TextureID(NullRecorder::createObject())
+	{
+		m_Loaded = true;
+		NullRecorder::upload(static_cast<uint64_t>(width) * height * 4);
+	}
+
+	void NullTexture2D::bind(int slot) const
+	{
+		NullRecorder::call();
+	}
+}
@@ -0,0 +1,40 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/Null/NullVertexArray.hpp"
+#include "Cardia/Renderer/Null/NullRecorder.hpp"
+
+
+namespace Cardia
+{
+	NullVertexArray::NullVertexArray()
+	{
+		NullRecorder::createObject();
+	}
+
+	void NullVertexArray::bind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullVertexArray::unbind() const
+	{
+		NullRecorder::call();
+	}
+
+	void NullVertexArray::setVertexBuffer(std::unique_ptr<VertexBuffer> vertexBuffer)
+	{
+		NullRecorder::call();
+		m_VertexBuffer = std::move(vertexBuffer);
+	}
+
+	void NullVertexArray::setIndexBuffer(std::unique_ptr<IndexBuffer> indexBuffer)
+	{
+		NullRecorder::call();
+		m_IndexBuffer = std::move(indexBuffer);
+	}
+
+	void NullVertexArray::setInstanceBuffer(std::unique_ptr<VertexBuffer> instanceBuffer)
+	{
+		NullRecorder::call();
+		m_InstanceBuffer = std::move(instanceBuffer);
+	}
+}
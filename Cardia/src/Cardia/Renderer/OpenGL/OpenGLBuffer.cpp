@@ -1,46 +1,176 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLBuffer.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
 
 #include <glad/glad.h>
 
 
 namespace Cardia
 {
+	constexpr GLbitfield persistentMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	constexpr GLuint64 fenceTimeout = 1000000000; // 1s, in nanoseconds
+
+	// Persistent Ring
+
+	void OpenGLPersistentRing::create(uint32_t bufferID, uint32_t regionSize)
+	{
+		m_RegionSize = regionSize;
+		const GLsizeiptr totalSize = static_cast<GLsizeiptr>(regionSize) * streamingBufferRegions;
+		glNamedBufferStorage(bufferID, totalSize, nullptr, persistentMapFlags);
+		m_MappedData = static_cast<uint8_t*>(glMapNamedBufferRange(bufferID, 0, totalSize, persistentMapFlags));
+		cdCoreAssert(m_MappedData, "Unable to persistently map streaming buffer");
+	}
+
+	void OpenGLPersistentRing::destroy()
+	{
+		for (auto& fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync(static_cast<GLsync>(fence));
+			fence = nullptr;
+		}
+		m_MappedData = nullptr;
+	}
+
+	void* OpenGLPersistentRing::map(uint32_t size, uint32_t alignment, uint32_t& offset)
+	{
+		cdCoreAssert(size <= m_RegionSize, "Streaming allocation is bigger than a whole region");
+
+		const uint32_t regionStart = m_Region * m_RegionSize;
+		uint32_t start = regionStart + m_Cursor;
+		if (alignment > 1)
+			start = (start + alignment - 1) / alignment * alignment;
+
+		if (start + size > regionStart + m_RegionSize)
+		{
+			// Region exhausted in the middle of a frame, move on to the next one
+			advance();
+			return map(size, alignment, offset);
+		}
+
+		m_Unfenced[m_Region] = true;
+		m_Cursor = start + size - regionStart;
+		offset = start;
+		return m_MappedData + start;
+	}
+
+	void OpenGLPersistentRing::fence()
+	{
+		for (uint32_t region = 0; region < streamingBufferRegions; ++region)
+		{
+			if (!m_Unfenced[region])
+				continue;
+			// The new fence signals after the old one, which is no longer needed
+			if (m_Fences[region])
+				glDeleteSync(static_cast<GLsync>(m_Fences[region]));
+			m_Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			m_Unfenced[region] = false;
+		}
+	}
+
+	void OpenGLPersistentRing::nextFrame()
+	{
+		fence();
+		advance();
+	}
+
+	void OpenGLPersistentRing::advance()
+	{
+		const uint32_t next = (m_Region + 1) % streamingBufferRegions;
+		cdCoreAssert(!m_Unfenced[next], "Streaming uploads wrapped around onto a region that is not drawn yet");
+		m_Region = next;
+		m_Cursor = 0;
+		waitRegion(m_Region);
+	}
+
+	void OpenGLPersistentRing::waitRegion(uint32_t region)
+	{
+		const auto fence = static_cast<GLsync>(m_Fences[region]);
+		if (!fence)
+			return;
+
+		GLbitfield flags = 0;
+		while (true)
+		{
+			const GLenum result = glClientWaitSync(fence, flags, fenceTimeout);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+				break;
+			if (result == GL_WAIT_FAILED)
+			{
+				Log::coreError("Streaming buffer fence wait failed");
+				break;
+			}
+			flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		}
+		glDeleteSync(fence);
+		m_Fences[region] = nullptr;
+	}
+
 	// Vertex Buffer
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size, bool streaming)
+		: m_Streaming(streaming)
 	{
 		glCreateBuffers(1, &m_VertexBufferID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
+		if (m_Streaming)
+			m_Ring.create(m_VertexBufferID, size);
+		else
+			glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
 	}
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(Vertex* vertices, uint32_t size)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const void* vertices, uint32_t size)
 	{
 		glCreateBuffers(1, &m_VertexBufferID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
+		OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
+		if (m_Streaming)
+			m_Ring.destroy();
+		OpenGLStateCache::forgetBuffer(m_VertexBufferID);
 		glDeleteBuffers(1, &m_VertexBufferID);
 	}
 
 	void OpenGLVertexBuffer::bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
+		OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
 	}
 
 	void OpenGLVertexBuffer::unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void OpenGLVertexBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		cdCoreAssert(!m_Streaming, "Streaming buffers are immutable, write through map() instead");
+		glNamedBufferSubData(m_VertexBufferID, offset, size, data);
+	}
+
+	void OpenGLVertexBuffer::bindStorage(int index) const
+	{
+		OpenGLStateCache::bindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_VertexBufferID);
+	}
+
+	void* OpenGLVertexBuffer::map(uint32_t size, uint32_t alignment, uint32_t& offset)
+	{
+		cdCoreAssert(m_Streaming, "Only streaming buffers can be mapped");
+		return m_Ring.map(size, alignment, offset);
 	}
 
-	void OpenGLVertexBuffer::setData(const void* data, uint32_t size)
+	void OpenGLVertexBuffer::fence()
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		if (m_Streaming)
+			m_Ring.fence();
+	}
+
+	void OpenGLVertexBuffer::nextFrame()
+	{
+		if (m_Streaming)
+			m_Ring.nextFrame();
 	}
 
 
@@ -48,72 +178,156 @@ namespace Cardia
 		: m_Count(count)
 	{
 		glCreateBuffers(1, &m_IndexBufferID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
+		OpenGLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
 	}
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t count)
+	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t count, bool streaming)
+		: m_Streaming(streaming)
 	{
 		glCreateBuffers(1, &m_IndexBufferID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
+		OpenGLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
+		if (m_Streaming)
+			m_Ring.create(m_IndexBufferID, count * sizeof(uint32_t));
+		else
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
+		if (m_Streaming)
+			m_Ring.destroy();
+		OpenGLStateCache::forgetBuffer(m_IndexBufferID);
 		glDeleteBuffers(1, &m_IndexBufferID);
 	}
 
 	void OpenGLIndexBuffer::bind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
+		OpenGLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
 	}
 
 	void OpenGLIndexBuffer::unbind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		OpenGLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	void OpenGLIndexBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		cdCoreAssert(!m_Streaming, "Streaming buffers are immutable, write through map() instead");
+		glNamedBufferSubData(m_IndexBufferID, offset, size, data);
+	}
+
+	void* OpenGLIndexBuffer::map(uint32_t size, uint32_t alignment, uint32_t& offset)
+	{
+		cdCoreAssert(m_Streaming, "Only streaming buffers can be mapped");
+		return m_Ring.map(size, alignment, offset);
 	}
 
-	void OpenGLIndexBuffer::setData(const void* data, uint32_t size)
+	void OpenGLIndexBuffer::fence()
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data);
+		if (m_Streaming)
+			m_Ring.fence();
+	}
+
+	void OpenGLIndexBuffer::nextFrame()
+	{
+		if (m_Streaming)
+			m_Ring.nextFrame();
 	}
 
 	OpenGLStorageBuffer::OpenGLStorageBuffer(void *data, uint32_t size)
 	{
 		glGenBuffers(1, &m_StorageBufferID);
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_StorageBufferID);
+		OpenGLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, m_StorageBufferID);
 		glBufferData(GL_SHADER_STORAGE_BUFFER, size, data, GL_DYNAMIC_COPY);
 	}
 
 	OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size)
 	{
 		glGenBuffers(1, &m_StorageBufferID);
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_StorageBufferID);
+		OpenGLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, m_StorageBufferID);
 		glBufferData(GL_SHADER_STORAGE_BUFFER, size, nullptr, GL_DYNAMIC_COPY);
 	}
 
 	OpenGLStorageBuffer::~OpenGLStorageBuffer()
 	{
+		OpenGLStateCache::forgetBuffer(m_StorageBufferID);
 		glDeleteBuffers(1, &m_StorageBufferID);
 	}
 
 	void OpenGLStorageBuffer::bind(int index) const
 	{
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_StorageBufferID);
-		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_StorageBufferID);
-
+		OpenGLStateCache::bindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_StorageBufferID);
 	}
 
 	void OpenGLStorageBuffer::unbind() const
 	{
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		OpenGLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void OpenGLStorageBuffer::setData(const void *data, uint32_t size, uint32_t offset)
+	{
+		OpenGLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, m_StorageBufferID);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+	}
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size)
+	{
+		glCreateBuffers(1, &m_UniformBufferID);
+		glNamedBufferData(m_UniformBufferID, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		OpenGLStateCache::forgetBuffer(m_UniformBufferID);
+		glDeleteBuffers(1, &m_UniformBufferID);
+	}
+
+	void OpenGLUniformBuffer::bind(int index) const
+	{
+		OpenGLStateCache::bindBufferBase(GL_UNIFORM_BUFFER, index, m_UniformBufferID);
+	}
+
+	void OpenGLUniformBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		glNamedBufferSubData(m_UniformBufferID, offset, size, data);
+	}
+
+	OpenGLIndirectBuffer::OpenGLIndirectBuffer(uint32_t size)
+		: m_Size(size)
+	{
+		glCreateBuffers(1, &m_IndirectBufferID);
+		glNamedBufferData(m_IndirectBufferID, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	OpenGLIndirectBuffer::~OpenGLIndirectBuffer()
+	{
+		OpenGLStateCache::forgetBuffer(m_IndirectBufferID);
+		glDeleteBuffers(1, &m_IndirectBufferID);
+	}
+
+	void OpenGLIndirectBuffer::bind() const
+	{
+		OpenGLStateCache::bindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBufferID);
+	}
+
+	void OpenGLIndirectBuffer::unbind() const
+	{
+		OpenGLStateCache::bindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void OpenGLIndirectBuffer::bindStorage(int index) const
+	{
+		OpenGLStateCache::bindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_IndirectBufferID);
+	}
+
+	void OpenGLIndirectBuffer::bindParameter() const
+	{
+		OpenGLStateCache::bindBuffer(GL_PARAMETER_BUFFER, m_IndirectBufferID);
 	}
 
-	void OpenGLStorageBuffer::setData(const void *data, uint32_t size)
+	void OpenGLIndirectBuffer::setData(const void* data, uint32_t size, uint32_t offset)
 	{
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_StorageBufferID);
-		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, data);
+		glNamedBufferSubData(m_IndirectBufferID, offset, size, data);
 	}
 }
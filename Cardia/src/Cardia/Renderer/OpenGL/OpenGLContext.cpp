@@ -1,15 +1,50 @@
 #include "cdpch.hpp"
 #include "Cardia/Core/Core.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLContext.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLShader.hpp"
 
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
+#include <string_view>
 
 
+// Lets the driver compile shaders on its own threads, OpenGLShader polls them before the first bind
+static void EnableParallelShaderCompile(Cardia::OpenGLContext::ProcLoader loader)
+{
+	using MaxShaderCompilerThreadsProc = void (APIENTRY*)(GLuint count);
+
+	GLint extensionCount = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+	for (GLint i = 0; i < extensionCount; i++)
+	{
+		const std::string_view extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+		const char* procName = nullptr;
+		if (extension == "GL_KHR_parallel_shader_compile")
+			procName = "glMaxShaderCompilerThreadsKHR";
+		else if (extension == "GL_ARB_parallel_shader_compile")
+			procName = "glMaxShaderCompilerThreadsARB";
+		else
+			continue;
+
+		if (const auto maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loader(procName)))
+		{
+			maxShaderCompilerThreads(0xFFFFFFFF); // Implementation-chosen thread count
+			Cardia::OpenGLShader::setCompletionStatusQuery(true);
+			Log::coreInfo("Parallel shader compilation enabled ({0})", extension);
+			return;
+		}
+	}
+}
+
 void Cardia::OpenGLContext::init()
 {
 	glfwMakeContextCurrent(m_Window);
-	const int result = gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+	loadGL(reinterpret_cast<ProcLoader>(glfwGetProcAddress));
+}
+
+void Cardia::OpenGLContext::loadGL(ProcLoader loader)
+{
+	const int result = gladLoadGLLoader(loader);
 	cdCoreAssert(result, "Could not load Glad");
 	Log::coreInfo("OpenGL : {0} | {1} | {2}",
 			glGetString(GL_VENDOR), glGetString(GL_RENDERER), glGetString(GL_VERSION));
@@ -18,6 +53,8 @@ void Cardia::OpenGLContext::init()
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_CULL_FACE);
+
+	EnableParallelShaderCompile(loader);
 }
 
 void Cardia::OpenGLContext::swapBuffers()
@@ -25,6 +62,16 @@ void Cardia::OpenGLContext::swapBuffers()
 	glfwSwapBuffers(m_Window);
 }
 
+void Cardia::OpenGLContext::makeCurrent()
+{
+	glfwMakeContextCurrent(m_Window);
+}
+
+void Cardia::OpenGLContext::releaseCurrent()
+{
+	glfwMakeContextCurrent(nullptr);
+}
+
 Cardia::OpenGLContext::OpenGLContext(GLFWwindow *window)
 	: m_Window(window)
 {
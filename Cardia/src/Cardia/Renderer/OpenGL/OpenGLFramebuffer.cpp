@@ -1,5 +1,6 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLFramebuffer.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
 #include "Cardia/Core/Core.hpp"
 
 #include <glad/glad.h>
@@ -9,53 +10,6 @@
 
 namespace Cardia {
 
-	static GLenum TextureTarget(bool multisampled)
-	{
-		return multisampled ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
-	}
-
-	static void AttachColorTexture(uint32_t id, uint32_t samples, GLenum internalFormat, GLenum format, uint32_t width, uint32_t height, uint32_t index)
-	{
-		bool multisampled = samples > 1;
-		if (multisampled)
-		{
-			glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, internalFormat, width, height, GL_FALSE);
-		}
-		else
-		{
-			glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
-
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		}
-
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + index, TextureTarget(multisampled), id, 0);
-	}
-
-	static void AttachDepthTexture(uint32_t id, int samples, GLenum format, GLenum attachmentType, uint32_t width, uint32_t height)
-	{
-		bool multisampled = samples > 1;
-		if (multisampled)
-		{
-			glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, format, width, height, GL_FALSE);
-		}
-		else
-		{
-			glTexStorage2D(GL_TEXTURE_2D, 1, format, width, height);
-
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		}
-
-		glFramebufferTexture2D(GL_FRAMEBUFFER, attachmentType, TextureTarget(multisampled), id, 0);
-	}
-
 	OpenGLFramebuffer::OpenGLFramebuffer(FramebufferSpec spec) : m_Spec(std::move(spec))
 	{
 		for (auto attachment : m_Spec.attachments.Attachments)
@@ -65,24 +19,28 @@ namespace Cardia {
 			else
 				m_DepthAttachmentSpecification = attachment;
 		}
-		GenerateFramebuffer();
+		glCreateFramebuffers(1, &m_FramebufferID);
+		GenerateFramebuffer(RenderTargetBucketSize(m_Spec.width), RenderTargetBucketSize(m_Spec.height));
 	}
 
 	OpenGLFramebuffer::~OpenGLFramebuffer()
 	{
+		ReleaseAttachments();
 		glDeleteFramebuffers(1, &m_FramebufferID);
-		glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
-		glDeleteTextures(1, &m_DepthAttachment);
 	}
 
 	void OpenGLFramebuffer::Bind() const
 	{
 		glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
 		glViewport(0, 0, m_Spec.width, m_Spec.height);
+		// Attachments can be larger, clears must not touch the unused part
+		OpenGLStateCache::setCapability(GL_SCISSOR_TEST, true);
+		glScissor(0, 0, m_Spec.width, m_Spec.height);
 	}
 
 	void OpenGLFramebuffer::Unbind() const
 	{
+		OpenGLStateCache::setCapability(GL_SCISSOR_TEST, false);
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
@@ -96,73 +54,66 @@ namespace Cardia {
 
 		m_Spec.width = width;
 		m_Spec.height = height;
-		GenerateFramebuffer();
+
+		// Dragging a splitter resizes every frame: attachments grow as soon as the size crosses a bucket,
+		// but only shrink once a whole bucket would stay unused, in between only the viewport changes
+		const int attachmentWidth = RenderTargetBucketSize(width);
+		const int attachmentHeight = RenderTargetBucketSize(height);
+		const bool grow = attachmentWidth > m_AttachmentWidth || attachmentHeight > m_AttachmentHeight;
+		const bool shrink = m_AttachmentWidth - attachmentWidth > renderTargetBucket || m_AttachmentHeight - attachmentHeight > renderTargetBucket;
+		if (grow || shrink)
+			GenerateFramebuffer(attachmentWidth, attachmentHeight);
 	}
 
-	void OpenGLFramebuffer::GenerateFramebuffer()
+	OpenGLRenderTargetPool::Key OpenGLFramebuffer::AttachmentKey(FramebufferTextureFormat format) const
 	{
-		if (m_FramebufferID)
-		{
-			glDeleteFramebuffers(1, &m_FramebufferID);
-			glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
-			glDeleteTextures(1, &m_DepthAttachment);
+		return { RenderTargetInternalFormat(format), m_AttachmentWidth, m_AttachmentHeight, m_Spec.samples };
+	}
 
-			m_ColorAttachments.clear();
-			m_DepthAttachment = 0;
-		}
+	void OpenGLFramebuffer::ReleaseAttachments()
+	{
+		for (size_t i = 0; i < m_ColorAttachments.size(); ++i)
+			OpenGLRenderTargetPool::release(AttachmentKey(m_ColorAttachmentSpecifications[i].TextureFormat), m_ColorAttachments[i]);
+		if (m_DepthAttachment)
+			OpenGLRenderTargetPool::release(AttachmentKey(m_DepthAttachmentSpecification.TextureFormat), m_DepthAttachment);
 
-		glGenFramebuffers(1, &m_FramebufferID);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
-		bool multisample = m_Spec.samples > 1;
-
-
-		if (m_ColorAttachmentSpecifications.size()) {
-			m_ColorAttachments.resize(m_ColorAttachmentSpecifications.size());
-			glCreateTextures(TextureTarget(multisample), m_ColorAttachments.size(), m_ColorAttachments.data());
-
-			for (size_t i = 0; i < m_ColorAttachments.size(); i++)
-			{
-				glBindTexture(TextureTarget(multisample), m_ColorAttachments[i]);
-				switch (m_ColorAttachmentSpecifications[i].TextureFormat)
-				{
-					case FramebufferTextureFormat::RGBA8:
-						AttachColorTexture(m_ColorAttachments[i], m_Spec.samples, GL_RGBA8, GL_RGBA, m_Spec.width, m_Spec.height, i);
-						break;
-					case FramebufferTextureFormat::RED_INTEGER:
-						AttachColorTexture(m_ColorAttachments[i], m_Spec.samples, GL_R32I, GL_RED_INTEGER, m_Spec.width, m_Spec.height, i);
-						break;
-					default:break;
-				}
-			}
+		m_ColorAttachments.clear();
+		m_DepthAttachment = 0;
+	}
+
+	void OpenGLFramebuffer::GenerateFramebuffer(int attachmentWidth, int attachmentHeight)
+	{
+		// Old attachments go back to the pool, a size seen before gets its textures back
+		ReleaseAttachments();
+		m_AttachmentWidth = attachmentWidth;
+		m_AttachmentHeight = attachmentHeight;
+
+		for (size_t i = 0; i < m_ColorAttachmentSpecifications.size(); i++)
+		{
+			const uint32_t texture = OpenGLRenderTargetPool::acquire(AttachmentKey(m_ColorAttachmentSpecifications[i].TextureFormat));
+			glNamedFramebufferTexture(m_FramebufferID, GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i), texture, 0);
+			m_ColorAttachments.push_back(texture);
 		}
 
 		if (m_DepthAttachmentSpecification.TextureFormat != FramebufferTextureFormat::None)
 		{
-			glCreateTextures(TextureTarget(multisample), 1, &m_DepthAttachment);
-			glBindTexture(TextureTarget(multisample), m_DepthAttachment);
-			switch (m_DepthAttachmentSpecification.TextureFormat)
-			{
-				case FramebufferTextureFormat::DEPTH24STENCIL8:
-					AttachDepthTexture(m_DepthAttachment,  m_Spec.samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_Spec.width, m_Spec.height);
-					break;
-				default:break;
-			}
+			m_DepthAttachment = OpenGLRenderTargetPool::acquire(AttachmentKey(m_DepthAttachmentSpecification.TextureFormat));
+			glNamedFramebufferTexture(m_FramebufferID, GL_DEPTH_STENCIL_ATTACHMENT, m_DepthAttachment, 0);
 		}
 
 		if (m_ColorAttachments.size() > 1)
 		{
 			cdCoreAssert(m_ColorAttachments.size() <= 4, "Color attachment size cannot be less than 4");
 			GLenum buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
-			glDrawBuffers(m_ColorAttachments.size(), buffers);
+			glNamedFramebufferDrawBuffers(m_FramebufferID, static_cast<int>(m_ColorAttachments.size()), buffers);
 		}
 		else if (m_ColorAttachments.empty())
 		{
 			// Only depth-pass
-			glDrawBuffer(GL_NONE);
+			glNamedFramebufferDrawBuffer(m_FramebufferID, GL_NONE);
 		}
 
-		cdCoreAssert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is not complete!");
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		cdCoreAssert(glCheckNamedFramebufferStatus(m_FramebufferID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is not complete!");
 	}
 
 	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
@@ -176,6 +127,17 @@ namespace Cardia {
 
 	}
 
+	void OpenGLFramebuffer::RequestPixels(uint32_t attachmentIndex, const PixelRegion& region)
+	{
+		cdCoreAssert(attachmentIndex < m_ColorAttachments.size(), "No attachment found");
+		m_PixelReader.request(m_ColorAttachments[attachmentIndex], region);
+	}
+
+	bool OpenGLFramebuffer::PollPixels(PixelRegion& region, std::vector<int>& pixels)
+	{
+		return m_PixelReader.poll(region, pixels);
+	}
+
 	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
 	{
 		cdCoreAssert(attachmentIndex < m_ColorAttachments.size(), "No attachment found");
@@ -0,0 +1,84 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLGpuProfiler.hpp"
+
+#include <glad/glad.h>
+
+
+namespace Cardia
+{
+	OpenGLGpuProfiler::OpenGLGpuProfiler()
+	{
+		for (auto& frame : m_Frames)
+			glGenQueries(static_cast<int>(frame.timestamps.size()), frame.timestamps.data());
+	}
+
+	OpenGLGpuProfiler::~OpenGLGpuProfiler()
+	{
+		for (auto& frame : m_Frames)
+			glDeleteQueries(static_cast<int>(frame.timestamps.size()), frame.timestamps.data());
+	}
+
+	void OpenGLGpuProfiler::begin(GpuPass pass)
+	{
+		if (!m_Recording)
+			return;
+		const auto index = static_cast<size_t>(pass);
+		glQueryCounter(m_Frames[m_CurrentFrame].timestamps[index * 2], GL_TIMESTAMP);
+	}
+
+	void OpenGLGpuProfiler::end(GpuPass pass)
+	{
+		if (!m_Recording)
+			return;
+		const auto index = static_cast<size_t>(pass);
+		auto& frame = m_Frames[m_CurrentFrame];
+		glQueryCounter(frame.timestamps[index * 2 + 1], GL_TIMESTAMP);
+		frame.recorded[index] = true;
+	}
+
+	void OpenGLGpuProfiler::nextFrame()
+	{
+		if (m_Recording)
+		{
+			auto& frame = m_Frames[m_CurrentFrame];
+			frame.pending = std::ranges::find(frame.recorded, true) != frame.recorded.end();
+		}
+
+		m_CurrentFrame = (m_CurrentFrame + 1) % gpuProfilerFrames;
+
+		// The slot is reused only once its results are in, until then the frame is not timed
+		auto& frame = m_Frames[m_CurrentFrame];
+		m_Recording = !frame.pending || collect(frame);
+		if (m_Recording)
+			frame.recorded.fill(false);
+	}
+
+	bool OpenGLGpuProfiler::collect(FrameQueries& frame)
+	{
+		// Asking for availability never stalls, asking for a result that is not there yet would
+		for (size_t pass = 0; pass < gpuPassCount; ++pass)
+		{
+			if (!frame.recorded[pass])
+				continue;
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(frame.timestamps[pass * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+		}
+
+		for (size_t pass = 0; pass < gpuPassCount; ++pass)
+		{
+			if (!frame.recorded[pass])
+			{
+				m_Milliseconds[pass] = 0.0f;
+				continue;
+			}
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(frame.timestamps[pass * 2], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(frame.timestamps[pass * 2 + 1], GL_QUERY_RESULT, &end);
+			m_Milliseconds[pass] = static_cast<float>(end - begin) / 1.0e6f;
+		}
+		frame.pending = false;
+		return true;
+	}
+}
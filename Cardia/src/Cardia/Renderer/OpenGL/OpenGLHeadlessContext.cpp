@@ -0,0 +1,92 @@
+#if defined(__linux__)
+
+#include "cdpch.hpp"
+#include "Cardia/Core/Core.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLContext.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLHeadlessContext.hpp"
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+
+namespace Cardia
+{
+	static void* EglProcAddress(const char* name)
+	{
+		return reinterpret_cast<void*>(eglGetProcAddress(name));
+	}
+
+	static EGLDisplay GetHeadlessDisplay()
+	{
+		// Mesa's surfaceless platform needs neither X11 nor Wayland, nor a render node
+		const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		if (getPlatformDisplay)
+		{
+			const EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+			if (display != EGL_NO_DISPLAY)
+				return display;
+		}
+		return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+
+	OpenGLHeadlessContext::~OpenGLHeadlessContext()
+	{
+		if (!m_Display)
+			return;
+		eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (m_Context)
+			eglDestroyContext(m_Display, m_Context);
+		eglTerminate(m_Display);
+	}
+
+	void OpenGLHeadlessContext::init()
+	{
+		m_Display = GetHeadlessDisplay();
+		EGLint major, minor;
+		cdCoreAssert(m_Display != EGL_NO_DISPLAY && eglInitialize(m_Display, &major, &minor), "Could not initialize EGL");
+		cdCoreAssert(eglBindAPI(EGL_OPENGL_API), "EGL does not support desktop OpenGL");
+		Log::coreInfo("EGL {0}.{1} : {2}", major, minor, eglQueryString(m_Display, EGL_VENDOR));
+
+		const EGLint configAttributes[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+		EGLConfig config = nullptr;
+		EGLint configCount = 0;
+		eglChooseConfig(m_Display, configAttributes, &config, 1, &configCount);
+		cdCoreAssert(configCount > 0, "No EGL config for desktop OpenGL");
+
+		// Same version as the shaders, drawn without any surface
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 6,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		m_Context = eglCreateContext(m_Display, config, EGL_NO_CONTEXT, contextAttributes);
+		cdCoreAssert(m_Context != EGL_NO_CONTEXT, "Could not create a headless OpenGL 4.6 context");
+
+		makeCurrent();
+		OpenGLContext::loadGL(EglProcAddress);
+	}
+
+	void OpenGLHeadlessContext::swapBuffers()
+	{
+		// Nothing is presented, the frame is only sent to the driver
+		glFlush();
+	}
+
+	void OpenGLHeadlessContext::makeCurrent()
+	{
+		eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_Context);
+	}
+
+	void OpenGLHeadlessContext::releaseCurrent()
+	{
+		eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	}
+}
+
+#endif
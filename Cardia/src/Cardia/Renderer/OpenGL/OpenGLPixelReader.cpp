@@ -0,0 +1,77 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLPixelReader.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
+
+#include <glad/glad.h>
+
+
+namespace Cardia
+{
+	OpenGLPixelReader::~OpenGLPixelReader()
+	{
+		for (auto& readback : m_PendingReadbacks)
+		{
+			glDeleteSync(static_cast<GLsync>(readback.fence));
+			m_FreeReadbacks.push_back(readback);
+		}
+		for (const auto& readback : m_FreeReadbacks)
+		{
+			OpenGLStateCache::forgetBuffer(readback.buffer);
+			glDeleteBuffers(1, &readback.buffer);
+		}
+	}
+
+	void OpenGLPixelReader::request(uint32_t texture, const PixelRegion& region)
+	{
+		// A new buffer is only created while every other one is still in flight
+		PixelReadback readback;
+		if (!m_FreeReadbacks.empty())
+		{
+			readback = m_FreeReadbacks.back();
+			m_FreeReadbacks.pop_back();
+		}
+		else
+		{
+			glCreateBuffers(1, &readback.buffer);
+		}
+
+		const auto size = static_cast<uint32_t>(region.width * region.height) * sizeof(int);
+		if (size > readback.capacity)
+		{
+			readback.capacity = size;
+			glNamedBufferData(readback.buffer, size, nullptr, GL_STREAM_READ);
+		}
+
+		// With a pack buffer bound, the read only queues a copy into it. The texture does not need to be attached anywhere
+		OpenGLStateCache::bindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+		glGetTextureSubImage(texture, 0, region.x, region.y, 0, region.width, region.height, 1,
+				     GL_RED_INTEGER, GL_INT, static_cast<int>(size), nullptr);
+		OpenGLStateCache::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		readback.region = region;
+		readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_PendingReadbacks.push_back(readback);
+	}
+
+	bool OpenGLPixelReader::poll(PixelRegion& region, std::vector<int>& pixels)
+	{
+		if (m_PendingReadbacks.empty())
+			return false;
+
+		auto readback = m_PendingReadbacks.front();
+		const auto fence = static_cast<GLsync>(readback.fence);
+		// A zero timeout only asks, the flush makes sure the fence gets signaled eventually
+		if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+			return false;
+
+		glDeleteSync(fence);
+		readback.fence = nullptr;
+		m_PendingReadbacks.pop_front();
+
+		region = readback.region;
+		pixels.resize(static_cast<size_t>(region.width * region.height));
+		glGetNamedBufferSubData(readback.buffer, 0, static_cast<GLsizeiptr>(pixels.size() * sizeof(int)), pixels.data());
+		m_FreeReadbacks.push_back(readback);
+		return true;
+	}
+}
@@ -1,5 +1,7 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLRenderAPI.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLBuffer.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
 
 #include <glad/glad.h>
 
@@ -31,10 +33,43 @@ namespace Cardia
 		glClear(GL_DEPTH_BUFFER_BIT);
 	}
 
-	void OpenGLRenderAPI::drawIndexed(const VertexArray* vertexArray, uint32_t indexCount)
+	void OpenGLRenderAPI::drawIndexed(const VertexArray* vertexArray, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
 	{
 		const uint32_t count = indexCount ? indexCount : vertexArray->getIndexBuffer().getCount();
-		glDrawElements(GL_TRIANGLES, static_cast<int>(count), GL_UNSIGNED_INT, nullptr);
+		const auto indexOffset = reinterpret_cast<const void*>(static_cast<size_t>(firstIndex) * sizeof(uint32_t));
+		glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<int>(count), GL_UNSIGNED_INT, indexOffset, baseVertex);
+	}
+
+	void OpenGLRenderAPI::drawIndexedInstanced(const VertexArray* vertexArray, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		const auto count = vertexArray->getIndexBuffer().getCount();
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, static_cast<int>(instanceCount), baseInstance);
+	}
+
+	void OpenGLRenderAPI::multiDrawIndexedIndirect(const VertexArray* vertexArray, const IndirectBuffer& commands, uint32_t drawCount, uint32_t firstCommand)
+	{
+		commands.bind();
+		const auto commandOffset = reinterpret_cast<const void*>(static_cast<size_t>(firstCommand) * sizeof(DrawElementsIndirectCommand));
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, commandOffset, static_cast<int>(drawCount), 0);
+	}
+
+	void OpenGLRenderAPI::multiDrawIndexedIndirectCount(const VertexArray* vertexArray, const IndirectBuffer& commands, const IndirectBuffer& drawCounts, uint32_t countIndex, uint32_t maxDrawCount, uint32_t firstCommand)
+	{
+		commands.bind();
+		static_cast<const OpenGLIndirectBuffer&>(drawCounts).bindParameter();
+		const auto commandOffset = reinterpret_cast<const void*>(static_cast<size_t>(firstCommand) * sizeof(DrawElementsIndirectCommand));
+		const auto countOffset = static_cast<GLintptr>(countIndex) * static_cast<GLintptr>(sizeof(uint32_t));
+		glMultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT, commandOffset, countOffset, static_cast<int>(maxDrawCount), 0);
+	}
+
+	void OpenGLRenderAPI::dispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		glDispatchCompute(groupsX, groupsY, groupsZ);
+	}
+
+	void OpenGLRenderAPI::computeBarrier()
+	{
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
 	}
 
 	std::string OpenGLRenderAPI::getVendor()
@@ -52,13 +87,64 @@ namespace Cardia
 		return {reinterpret_cast<const char*>(glGetString(GL_VERSION))};
 	}
 
+	int OpenGLRenderAPI::getMaxTextureSlots()
+	{
+		if (!m_MaxTextureSlots)
+			glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &m_MaxTextureSlots);
+		return m_MaxTextureSlots;
+	}
+
 	void OpenGLRenderAPI::enableDepth()
 	{
-		glEnable(GL_DEPTH_TEST);
+		OpenGLStateCache::setCapability(GL_DEPTH_TEST, true);
 	}
 
 	void OpenGLRenderAPI::disableDepth()
 	{
-		glDisable(GL_DEPTH_TEST);
+		OpenGLStateCache::setCapability(GL_DEPTH_TEST, false);
+	}
+
+	void OpenGLRenderAPI::enableBlending()
+	{
+		OpenGLStateCache::setCapability(GL_BLEND, true);
+	}
+
+	void OpenGLRenderAPI::disableBlending()
+	{
+		OpenGLStateCache::setCapability(GL_BLEND, false);
+	}
+
+	void OpenGLRenderAPI::setDepthFunction(DepthFunction function)
+	{
+		switch (function)
+		{
+			case DepthFunction::Less: OpenGLStateCache::setDepthFunc(GL_LESS); break;
+			case DepthFunction::Equal: OpenGLStateCache::setDepthFunc(GL_EQUAL); break;
+		}
+	}
+
+	void OpenGLRenderAPI::setDepthWrite(bool state)
+	{
+		OpenGLStateCache::setDepthMask(state);
+	}
+
+	void OpenGLRenderAPI::setColorWrite(bool state)
+	{
+		OpenGLStateCache::setColorMask(state);
+	}
+
+	RenderAPI::StateCounters OpenGLRenderAPI::getStateCounters()
+	{
+		return OpenGLStateCache::getCounters();
+	}
+
+	void OpenGLRenderAPI::resetStateCounters()
+	{
+		OpenGLStateCache::resetCounters();
+	}
+
+	void OpenGLRenderAPI::invalidateStateCache()
+	{
+		OpenGLStateCache::invalidate();
 	}
 }
@@ -0,0 +1,118 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLRenderGraphBackend.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLRenderTargetPool.hpp"
+#include "Cardia/Core/Core.hpp"
+
+#include <glad/glad.h>
+
+
+namespace Cardia
+{
+	constexpr uint32_t maxPassColors = 4;
+
+	static OpenGLRenderTargetPool::Key PoolKey(const RenderGraphTextureDesc& desc)
+	{
+		return { RenderTargetInternalFormat(desc.format), RenderTargetBucketSize(desc.width), RenderTargetBucketSize(desc.height), desc.samples };
+	}
+
+	OpenGLRenderGraphBackend::~OpenGLRenderGraphBackend()
+	{
+		glDeleteFramebuffers(1, &m_Framebuffer);
+	}
+
+	uint32_t OpenGLRenderGraphBackend::acquireTexture(const RenderGraphTextureDesc& desc)
+	{
+		return OpenGLRenderTargetPool::acquire(PoolKey(desc));
+	}
+
+	void OpenGLRenderGraphBackend::releaseTexture(const RenderGraphTextureDesc& desc, uint32_t texture)
+	{
+		OpenGLRenderTargetPool::release(PoolKey(desc), texture);
+	}
+
+	void OpenGLRenderGraphBackend::clearTexture(uint32_t texture, const RenderGraphTextureDesc& desc)
+	{
+		// Clears the whole texture whatever the write masks and scissor are
+		switch (desc.format)
+		{
+			case FramebufferTextureFormat::RGBA8:
+				glClearTexImage(texture, 0, GL_RGBA, GL_FLOAT, &desc.clearValue);
+				break;
+			case FramebufferTextureFormat::RED_INTEGER:
+			{
+				const int value = static_cast<int>(desc.clearValue.x);
+				glClearTexImage(texture, 0, GL_RED_INTEGER, GL_INT, &value);
+				break;
+			}
+			case FramebufferTextureFormat::DEPTH24STENCIL8:
+			{
+				const struct { float depth; uint32_t stencil; } value { 1.0f, 0 };
+				glClearTexImage(texture, 0, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, &value);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	void OpenGLRenderGraphBackend::beginPass(const std::vector<uint32_t>& colors, uint32_t depth, int width, int height)
+	{
+		cdCoreAssert(colors.size() <= maxPassColors, "A render graph pass cannot write more than 4 colors");
+		if (!m_Framebuffer)
+			glCreateFramebuffers(1, &m_Framebuffer);
+
+		// Culled outputs keep their location, nothing is written there
+		GLenum buffers[maxPassColors];
+		for (uint32_t i = 0; i < colors.size(); ++i)
+		{
+			glNamedFramebufferTexture(m_Framebuffer, GL_COLOR_ATTACHMENT0 + i, colors[i], 0);
+			buffers[i] = colors[i] ? GL_COLOR_ATTACHMENT0 + i : GL_NONE;
+		}
+		for (auto i = static_cast<uint32_t>(colors.size()); i < m_AttachedColors; ++i)
+			glNamedFramebufferTexture(m_Framebuffer, GL_COLOR_ATTACHMENT0 + i, 0, 0);
+		m_AttachedColors = static_cast<uint32_t>(colors.size());
+		glNamedFramebufferTexture(m_Framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, depth, 0);
+
+		if (colors.empty())
+			glNamedFramebufferDrawBuffer(m_Framebuffer, GL_NONE);
+		else
+			glNamedFramebufferDrawBuffers(m_Framebuffer, static_cast<int>(colors.size()), buffers);
+
+		cdCoreAssert(glCheckNamedFramebufferStatus(m_Framebuffer, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Render graph pass framebuffer is not complete!");
+		glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+		// Pooled textures are rounded up to a bucket, only the bottom left width x height pixels are used
+		glViewport(0, 0, width, height);
+	}
+
+	void OpenGLRenderGraphBackend::endPass()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void OpenGLRenderGraphBackend::barrier(RenderGraphAccess access)
+	{
+		// GL already orders rasterized writes before later reads, the bits cover passes writing through image stores
+		switch (access)
+		{
+			case RenderGraphAccess::RenderTarget:
+				glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+				break;
+			case RenderGraphAccess::Sampled:
+				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+				break;
+			case RenderGraphAccess::Transfer:
+				glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+				break;
+		}
+	}
+
+	void OpenGLRenderGraphBackend::requestPixels(uint32_t texture, const PixelRegion& region)
+	{
+		m_PixelReader.request(texture, region);
+	}
+
+	bool OpenGLRenderGraphBackend::pollPixels(PixelRegion& region, std::vector<int>& pixels)
+	{
+		return m_PixelReader.poll(region, pixels);
+	}
+}
@@ -0,0 +1,78 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLRenderTargetPool.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
+
+#include <glad/glad.h>
+
+
+namespace Cardia
+{
+	// Released textures kept at most, the least recently released ones are deleted first
+	constexpr size_t maxPooledRenderTargets = 8;
+
+	namespace
+	{
+		struct PooledTarget
+		{
+			OpenGLRenderTargetPool::Key key;
+			uint32_t texture;
+		};
+
+		std::vector<PooledTarget> s_FreeTargets; // Least recently released first
+
+		uint32_t CreateTarget(const OpenGLRenderTargetPool::Key& key)
+		{
+			uint32_t texture;
+			if (key.samples > 1)
+			{
+				glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &texture);
+				glTextureStorage2DMultisample(texture, static_cast<int>(key.samples), key.internalFormat, key.width, key.height, GL_FALSE);
+				return texture;
+			}
+
+			glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+			glTextureStorage2D(texture, 1, key.internalFormat, key.width, key.height);
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			return texture;
+		}
+	}
+
+	uint32_t RenderTargetInternalFormat(FramebufferTextureFormat format)
+	{
+		switch (format)
+		{
+			case FramebufferTextureFormat::RGBA8:           return GL_RGBA8;
+			case FramebufferTextureFormat::RED_INTEGER:     return GL_R32I;
+			case FramebufferTextureFormat::DEPTH24STENCIL8: return GL_DEPTH24_STENCIL8;
+			default: return GL_NONE;
+		}
+	}
+
+	uint32_t OpenGLRenderTargetPool::acquire(const Key& key)
+	{
+		// Most recently released first, it is the most likely to still be resident
+		const auto it = std::find_if(s_FreeTargets.rbegin(), s_FreeTargets.rend(), [&](const PooledTarget& target) { return target.key == key; });
+		if (it == s_FreeTargets.rend())
+			return CreateTarget(key);
+
+		const uint32_t texture = it->texture;
+		s_FreeTargets.erase(std::next(it).base());
+		return texture;
+	}
+
+	void OpenGLRenderTargetPool::release(const Key& key, uint32_t texture)
+	{
+		s_FreeTargets.push_back({ key, texture });
+		if (s_FreeTargets.size() <= maxPooledRenderTargets)
+			return;
+
+		const uint32_t oldest = s_FreeTargets.front().texture;
+		OpenGLStateCache::forgetTexture(oldest);
+		glDeleteTextures(1, &oldest);
+		s_FreeTargets.erase(s_FreeTargets.begin());
+	}
+}
@@ -1,14 +1,22 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLShader.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
 #include "Cardia/Core/Log.hpp"
 #include "Cardia/Core/Core.hpp"
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <numeric>
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
 
 namespace Cardia
 {
+	static bool s_CompletionStatusQuery = false;
+
 	static std::string LoadShader(const std::string& filePath)
 	{
 		Log::coreInfo("Loading shader (path: '" + filePath + "')...");
@@ -29,46 +37,161 @@ namespace Cardia
 		return string_hash(s);
 	}
 
-	OpenGLShader::OpenGLShader(std::initializer_list<std::string> filePaths)
+	static GLenum ShaderTypeFromExtension(const std::string& filePath)
 	{
-		// Vertex and fragment shaders are successfully compiled.
-		// Now time to link them together into a program.
-		// Get a program object.
-		m_ShaderID = glCreateProgram();
+		std::string extension = std::filesystem::path(filePath).extension().string();
+		switch (string_hash(extension.c_str()+1))
+		{
+			case "frag"_sh:
+				return GL_FRAGMENT_SHADER;
+			case "vert"_sh:
+				return GL_VERTEX_SHADER;
+			case "comp"_sh:
+				return GL_COMPUTE_SHADER;
+			default:
+				Log::coreError(extension);
+				cdCoreAssert(false, "Unsupported shader extension !");
+				return GL_NONE;
+		}
+	}
+
+	// Program binaries only load back on the driver that produced them
+	static const std::string& DriverSignature()
+	{
+		static const std::string signature = std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + '|'
+			+ reinterpret_cast<const char*>(glGetString(GL_RENDERER)) + '|'
+			+ reinterpret_cast<const char*>(glGetString(GL_VERSION));
+		return signature;
+	}
+
+	static std::filesystem::path ProgramCachePath(const std::vector<std::pair<GLenum, std::string>>& stages)
+	{
+		GLint binaryFormatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+		if (binaryFormatCount == 0)
+			return {};
+
+		std::error_code error;
+		const auto directory = std::filesystem::temp_directory_path(error) / "Cardia" / "ShaderCache";
+		if (error)
+			return {};
+
+		std::string key = DriverSignature();
+		for (const auto& [type, source] : stages)
+		{
+			key += '\0' + std::to_string(type) + '\0' + source;
+		}
+		std::stringstream fileName;
+		fileName << std::hex << std::hash<std::string>{}(key) << ".bin";
+		return directory / fileName.str();
+	}
+
+	static bool LoadProgramBinary(GLuint program, const std::filesystem::path& cachePath)
+	{
+		std::ifstream file(cachePath, std::ios::binary);
+		if (!file)
+			return false;
+
+		GLenum format = 0;
+		if (!file.read(reinterpret_cast<char*>(&format), sizeof(format)))
+			return false;
+		const std::vector<char> binary { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+		if (binary.empty())
+			return false;
+
+		glProgramBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			// Stale entry, a driver update can reject binaries without changing its version string
+			Log::coreWarn("Discarding shader cache entry {0}", cachePath.string());
+			std::error_code error;
+			std::filesystem::remove(cachePath, error);
+			return false;
+		}
+		return true;
+	}
+
+	static void SaveProgramBinary(GLuint program, const std::filesystem::path& cachePath)
+	{
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
 
-		std::vector<GLuint> shaderIDs {};
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, nullptr, &format, binary.data());
 
+		std::error_code error;
+		std::filesystem::create_directories(cachePath.parent_path(), error);
+		std::ofstream file(cachePath, std::ios::binary);
+		if (!file)
+		{
+			Log::coreWarn("Unable to write shader cache entry {0}", cachePath.string());
+			return;
+		}
+		file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+		file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+	}
+
+	// Defines have to follow #version, which must stay the first directive
+	static void InjectDefines(std::string& source, const std::string& defines)
+	{
+		if (defines.empty())
+			return;
+
+		const auto version = source.find("#version");
+		const auto lineEnd = version == std::string::npos ? std::string::npos : source.find('\n', version);
+		if (lineEnd == std::string::npos)
+			source.insert(0, defines);
+		else
+			source.insert(lineEnd + 1, defines);
+	}
+
+	OpenGLShader::OpenGLShader(const std::vector<std::string>& filePaths, ShaderFeatures features)
+	{
+		m_ShaderID = glCreateProgram();
+
+		const std::string defines = ShaderFeatureDefines(features);
+		std::vector<std::pair<GLenum, std::string>> stages;
 		for (auto& filePath : filePaths)
 		{
-			GLenum shaderType;
-			std::string extension = std::filesystem::path(filePath).extension().string();
-			switch (string_hash(extension.c_str()+1))
-			{
-				case "frag"_sh:
-					shaderType = GL_FRAGMENT_SHADER;
-					break;
-				case "vert"_sh:
-					shaderType = GL_VERTEX_SHADER;
-					break;
-				default:
-					shaderType = GL_NONE;
-					Log::coreError(extension);
-					cdCoreAssert(false, "Unsupported shader extension !");
-					break;
-			}
+			auto& stage = stages.emplace_back(ShaderTypeFromExtension(filePath), LoadShader(filePath));
+			InjectDefines(stage.second, defines);
+		}
 
-			// Create an empty shader handle
-			GLuint shader = glCreateShader(shaderType);
+		m_CachePath = ProgramCachePath(stages);
+		if (!m_CachePath.empty() && LoadProgramBinary(m_ShaderID, m_CachePath))
+		{
+			m_CachePath.clear();
+			reflectUniforms();
+			return;
+		}
 
-			// Send the vertex shader source code to GL
+		glProgramParameteri(m_ShaderID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		for (const auto& [type, strSource] : stages)
+		{
 			// Note that std::string's .c_str is NULL character terminated.
-			std::string strSource = LoadShader(filePath);
+			GLuint shader = glCreateShader(type);
 			const GLchar* source = strSource.c_str();
 			glShaderSource(shader, 1, &source, nullptr);
-
-			// Compile the vertex shader
 			glCompileShader(shader);
+			glAttachShader(m_ShaderID, shader);
+			m_PendingStages.push_back(shader);
+		}
+
+		// Statuses are only queried on first bind, querying them here would wait for the driver
+		// and serialize the compilation of every shader created in a row.
+		glLinkProgram(m_ShaderID);
+	}
 
+	void OpenGLShader::finishLink() const
+	{
+		bool failed = false;
+		for (auto& shader : m_PendingStages)
+		{
 			GLint isCompiled = 0;
 			glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
 			if (isCompiled == GL_FALSE)
@@ -79,29 +202,15 @@ namespace Cardia
 				// The maxLength includes the NULL character
 				std::vector<GLchar> infoLog(maxLength);
 				glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
-
-				// We don't need the shader anymore.
-				glDeleteShader(shader);
-
 				Log::coreError("Shader error : {0}", infoLog.data());
-				cdCoreAssert(false, "Unable to create OpenGL Shader !");
-				return;
+				failed = true;
 			}
-			shaderIDs.push_back(shader);
 		}
-		
-		for(auto& shaderID : shaderIDs)
-		{
-			glAttachShader(m_ShaderID, shaderID);
-		}
-
-		// Link our program
-		glLinkProgram(m_ShaderID);
 
 		// Note the different functions here: glGetProgram* instead of glGetShader*.
 		GLint isLinked = 0;
 		glGetProgramiv(m_ShaderID, GL_LINK_STATUS, &isLinked);
-		if (isLinked == GL_FALSE)
+		if (!failed && isLinked == GL_FALSE)
 		{
 			GLint maxLength = 0;
 			glGetProgramiv(m_ShaderID, GL_INFO_LOG_LENGTH, &maxLength);
@@ -109,64 +218,143 @@ namespace Cardia
 			// The maxLength includes the NULL character
 			std::vector<GLchar> infoLog(maxLength);
 			glGetProgramInfoLog(m_ShaderID, maxLength, &maxLength, &infoLog[0]);
+			Log::coreError("Linking Shader error : {0}", infoLog.data());
+			failed = true;
+		}
+
+		for (auto& shader : m_PendingStages)
+		{
+			glDetachShader(m_ShaderID, shader);
+			glDeleteShader(shader);
+		}
+		m_PendingStages.clear();
 
-			// We don't need the program anymore.
+		if (failed)
+		{
 			glDeleteProgram(m_ShaderID);
+			m_ShaderID = 0;
+			cdCoreAssert(false, "Unable to create OpenGL Shader !");
+			return;
+		}
+
+		if (!m_CachePath.empty())
+			SaveProgramBinary(m_ShaderID, m_CachePath);
+		reflectUniforms();
+	}
+
+	void OpenGLShader::reflectUniforms() const
+	{
+		GLint uniformCount = 0;
+		glGetProgramInterfaceiv(m_ShaderID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+
+		constexpr GLsizei propertyCount = 4;
+		constexpr GLenum properties[propertyCount] { GL_NAME_LENGTH, GL_LOCATION, GL_ARRAY_SIZE, GL_TYPE };
+		GLint maxTextureSlots = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureSlots);
+		std::string name;
+		for (GLint uniform = 0; uniform < uniformCount; ++uniform)
+		{
+			GLint values[propertyCount] {};
+			glGetProgramResourceiv(m_ShaderID, GL_UNIFORM, uniform, propertyCount, properties, propertyCount, nullptr, values);
+			const auto [nameLength, location, arraySize, type] = values;
 
-			for (auto& shaderID : shaderIDs)
+			// Members of uniform blocks have no location
+			if (location < 0)
+				continue;
+
+			name.resize(nameLength);
+			glGetProgramResourceName(m_ShaderID, GL_UNIFORM, uniform, nameLength, nullptr, name.data());
+			name.resize(nameLength - 1); // Drop the null terminator
+
+			m_UniformLocations[name] = location;
+			if (arraySize > 1 || name.ends_with("[0]"))
 			{
-				// Don't leak shaders either.
-				glDeleteShader(shaderID);
+				// Arrays are reported as "name[0]", both the bare name and every element can be set
+				const std::string baseName = name.substr(0, name.rfind('['));
+				m_UniformLocations[baseName] = location;
+				for (GLint element = 1; element < arraySize; ++element)
+				{
+					const std::string elementName = baseName + "[" + std::to_string(element) + "]";
+					m_UniformLocations[elementName] = glGetUniformLocation(m_ShaderID, elementName.c_str());
+				}
 			}
 
-			Log::coreError("Linking Shader error : {0}", infoLog.data());
-			cdCoreAssert(false, "Unable to link OpenGL Shaders !");
-			return;
+			if (type == GL_SAMPLER_2D && arraySize > 1)
+			{
+				std::vector<GLint> slots(std::min(arraySize, maxTextureSlots));
+				std::iota(slots.begin(), slots.end(), 0);
+				glProgramUniform1iv(m_ShaderID, location, static_cast<GLsizei>(slots.size()), slots.data());
+			}
 		}
+	}
 
-		for (auto& shaderID : shaderIDs)
-		{
-			glDetachShader(m_ShaderID, shaderID);
-		}
+	int OpenGLShader::getUniformLocation(const std::string& name) const
+	{
+		const auto location = m_UniformLocations.find(name);
+		return location != m_UniformLocations.end() ? location->second : -1;
 	}
 
 	void OpenGLShader::bind() const
 	{
-		glUseProgram(m_ShaderID);
+		if (!m_PendingStages.empty())
+			finishLink();
+		OpenGLStateCache::useProgram(m_ShaderID);
+	}
+
+	bool OpenGLShader::isReady() const
+	{
+		// Without the extension there is nothing to poll, the first bind waits for the link
+		if (m_PendingStages.empty() || !s_CompletionStatusQuery)
+			return true;
+
+		GLint completed = GL_FALSE;
+		glGetProgramiv(m_ShaderID, GL_COMPLETION_STATUS_KHR, &completed);
+		return completed == GL_TRUE;
+	}
+
+	void OpenGLShader::setCompletionStatusQuery(bool state)
+	{
+		s_CompletionStatusQuery = state;
 	}
 
 	void OpenGLShader::unbind() const
 	{
-		glUseProgram(0);
+		OpenGLStateCache::useProgram(0);
 	}
 
 	void OpenGLShader::setUniformMat4(const std::string& name, glm::mat4 matrix) const
 	{
-		GLint location = glGetUniformLocation(m_ShaderID, name.c_str());
+		const GLint location = getUniformLocation(name);
 		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
 	void OpenGLShader::setUniformFloat4(const std::string& name, glm::vec4 data) const
 	{
-		GLint location = glGetUniformLocation(m_ShaderID, name.c_str());
+		const GLint location = getUniformLocation(name);
 		glUniform4f(location, data.x, data.y, data.z, data.w);
 	}
 
+	void OpenGLShader::setUniformFloat4Array(const std::string& name, const glm::vec4* values, int count) const
+	{
+		const GLint location = getUniformLocation(name);
+		glUniform4fv(location, count, glm::value_ptr(*values));
+	}
+
 	void OpenGLShader::setUniformFloat3(const std::string& name, glm::vec3 data) const
 	{
-		GLint location = glGetUniformLocation(m_ShaderID, name.c_str());
+		const GLint location = getUniformLocation(name);
 		glUniform3f(location, data.x, data.y, data.z);
 	}
 
 	void OpenGLShader::setUniformInt(const std::string &name, int value) const
 	{
-		GLint location = glGetUniformLocation(m_ShaderID, name.c_str());
+		const GLint location = getUniformLocation(name);
 		glUniform1i(location, value);
 	}
 
 	void OpenGLShader::setUniformIntArray(const std::string &name, int *values, int count) const
 	{
-		GLint location = glGetUniformLocation(m_ShaderID, name.c_str());
+		const GLint location = getUniformLocation(name);
 		glUniform1iv(location, count, values);
 	}
 
@@ -175,6 +363,11 @@ namespace Cardia
 		setUniformFloat4(name, value);
 	}
 
+	void OpenGLShader::setFloat4Array(const std::string& name, const glm::vec4* values, int count)
+	{
+		setUniformFloat4Array(name, values, count);
+	}
+
 	void OpenGLShader::setFloat3(const std::string &name, const glm::vec3 &value)
 	{
 		setUniformFloat3(name, value);
@@ -0,0 +1,170 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
+
+#include <glad/glad.h>
+#include <limits>
+
+
+namespace Cardia
+{
+	namespace
+	{
+		// Nothing is assumed about a binding until it has been set through the cache
+		constexpr uint32_t unknown = std::numeric_limits<uint32_t>::max();
+
+		struct CachedState
+		{
+			uint32_t program = unknown;
+			uint32_t vertexArray = unknown;
+			std::unordered_map<uint32_t, uint32_t> buffers;
+			std::unordered_map<uint64_t, uint32_t> indexedBuffers;
+			std::vector<uint32_t> textureUnits;
+			std::unordered_map<uint32_t, bool> capabilities;
+			uint32_t depthFunc = unknown;
+			uint32_t depthMask = unknown;
+			uint32_t colorMask = unknown;
+			RenderAPI::StateCounters counters;
+		};
+
+		CachedState s_State;
+
+		// Records the new value and tells whether the GL call is needed
+		bool update(uint32_t& cached, uint32_t value)
+		{
+			if (cached == value)
+			{
+				s_State.counters.elided++;
+				return false;
+			}
+			cached = value;
+			s_State.counters.issued++;
+			return true;
+		}
+
+		uint32_t& cachedBuffer(uint32_t target)
+		{
+			return s_State.buffers.try_emplace(target, unknown).first->second;
+		}
+	}
+
+	void OpenGLStateCache::useProgram(uint32_t program)
+	{
+		if (update(s_State.program, program))
+			glUseProgram(program);
+	}
+
+	void OpenGLStateCache::bindVertexArray(uint32_t vertexArray)
+	{
+		if (!update(s_State.vertexArray, vertexArray))
+			return;
+		glBindVertexArray(vertexArray);
+		// The element array binding is part of the vertex array
+		s_State.buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+	}
+
+	void OpenGLStateCache::bindBuffer(uint32_t target, uint32_t buffer)
+	{
+		if (update(cachedBuffer(target), buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void OpenGLStateCache::bindBufferBase(uint32_t target, uint32_t index, uint32_t buffer)
+	{
+		const uint64_t key = static_cast<uint64_t>(target) << 32 | index;
+		auto& cached = s_State.indexedBuffers.try_emplace(key, unknown).first->second;
+		if (!update(cached, buffer))
+			return;
+		glBindBufferBase(target, index, buffer);
+		// Binding an indexed target also binds its generic binding point
+		cachedBuffer(target) = buffer;
+	}
+
+	void OpenGLStateCache::bindTextureUnit(uint32_t unit, uint32_t texture)
+	{
+		if (unit >= s_State.textureUnits.size())
+			s_State.textureUnits.resize(unit + 1, unknown);
+		if (update(s_State.textureUnits[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void OpenGLStateCache::setCapability(uint32_t capability, bool enabled)
+	{
+		const auto [cached, inserted] = s_State.capabilities.try_emplace(capability, enabled);
+		if (!inserted && cached->second == enabled)
+		{
+			s_State.counters.elided++;
+			return;
+		}
+		cached->second = enabled;
+		s_State.counters.issued++;
+		enabled ? glEnable(capability) : glDisable(capability);
+	}
+
+	void OpenGLStateCache::setDepthFunc(uint32_t function)
+	{
+		if (update(s_State.depthFunc, function))
+			glDepthFunc(function);
+	}
+
+	void OpenGLStateCache::setDepthMask(bool enabled)
+	{
+		if (update(s_State.depthMask, enabled))
+			glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+
+	void OpenGLStateCache::setColorMask(bool enabled)
+	{
+		if (!update(s_State.colorMask, enabled))
+			return;
+		const GLboolean mask = enabled ? GL_TRUE : GL_FALSE;
+		glColorMask(mask, mask, mask, mask);
+	}
+
+	void OpenGLStateCache::forgetBuffer(uint32_t buffer)
+	{
+		for (auto& [target, cached] : s_State.buffers)
+		{
+			if (cached == buffer)
+				cached = unknown;
+		}
+		for (auto& [key, cached] : s_State.indexedBuffers)
+		{
+			if (cached == buffer)
+				cached = unknown;
+		}
+	}
+
+	void OpenGLStateCache::forgetVertexArray(uint32_t vertexArray)
+	{
+		if (s_State.vertexArray != vertexArray)
+			return;
+		s_State.vertexArray = unknown;
+		s_State.buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+	}
+
+	void OpenGLStateCache::forgetTexture(uint32_t texture)
+	{
+		for (auto& cached : s_State.textureUnits)
+		{
+			if (cached == texture)
+				cached = unknown;
+		}
+	}
+
+	void OpenGLStateCache::invalidate()
+	{
+		const auto counters = s_State.counters;
+		s_State = CachedState();
+		s_State.counters = counters;
+	}
+
+	RenderAPI::StateCounters OpenGLStateCache::getCounters()
+	{
+		return s_State.counters;
+	}
+
+	void OpenGLStateCache::resetCounters()
+	{
+		s_State.counters = RenderAPI::StateCounters();
+	}
+}
@@ -1,22 +1,70 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLTexture.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
 #include "Cardia/Core/Core.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image/stb_image.h>
 #include <glad/glad.h>
+#include <array>
+
+// S3TC is not core, its enums are missing from core-only loaders
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
 
 
 namespace Cardia
 {
+	namespace
+	{
+		GLenum InternalFormat(TextureFormat format)
+		{
+			switch (format)
+			{
+				case TextureFormat::R8:		return GL_R8;
+				case TextureFormat::RG8:	return GL_RG8;
+				case TextureFormat::RGB8:	return GL_RGB8;
+				case TextureFormat::RGBA8:	return GL_RGBA8;
+				case TextureFormat::BC1:	return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+				case TextureFormat::BC1A:	return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+				case TextureFormat::BC3:	return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+				case TextureFormat::BC4:	return GL_COMPRESSED_RED_RGTC1;
+				case TextureFormat::BC5:	return GL_COMPRESSED_RG_RGTC2;
+				case TextureFormat::BC7:	return GL_COMPRESSED_RGBA_BPTC_UNORM;
+				default:
+					cdCoreAssert(false, "Unsupported texture format");
+					return 0;
+			}
+		}
+
+		GLenum DataFormat(TextureFormat format)
+		{
+			switch (format)
+			{
+				case TextureFormat::R8:		return GL_RED;
+				case TextureFormat::RG8:	return GL_RG;
+				case TextureFormat::RGB8:	return GL_RGB;
+				default:			return GL_RGBA;
+			}
+		}
+	}
+
 	OpenGLTexture2D::OpenGLTexture2D(std::string path)
 		:m_Width(), m_Height(), m_TextureID()
 	{
 		m_Path = std::move(path);
+		Log::coreInfo("Loading {0}...", m_Path);
+		if (IsTextureContainer(m_Path))
+		{
+			loadContainer();
+			return;
+		}
 		stbi_set_flip_vertically_on_load(true);
 
 		int width, height, nbChannels;
-		Log::coreInfo("Loading {0}...", m_Path);
 		unsigned char *data = stbi_load(m_Path.c_str(), &width, &height, &nbChannels, 0);
 		m_Loaded = true;
 		if (!data)
@@ -29,60 +77,92 @@ namespace Cardia
 		m_Width = width;
 		m_Height = height;
 
-		GLenum internalFormat = 0, dataFormat = 0;
-		if (nbChannels == 4)
+		constexpr std::array<TextureFormat, 4> channelFormats { TextureFormat::R8, TextureFormat::RG8, TextureFormat::RGB8, TextureFormat::RGBA8 };
+		const TextureFormat format = channelFormats[nbChannels - 1];
+		m_IsTransparent = nbChannels == 2 || nbChannels == 4;
+
+		// The whole chain is allocated, minified sprites sample the smaller levels instead of thrashing the cache
+		createStorage(format, MipLevelCount(m_Width, m_Height));
+
+		// Grey and grey-alpha images, sampled as colors
+		if (nbChannels <= 2)
 		{
-			internalFormat = GL_RGBA8;
-			dataFormat = GL_RGBA;
-			m_IsTransparent = true;
+			const GLint alpha = nbChannels == 2 ? GL_GREEN : GL_ONE;
+			const std::array<GLint, 4> swizzle { GL_RED, GL_RED, GL_RED, alpha };
+			glTextureParameteriv(m_TextureID, GL_TEXTURE_SWIZZLE_RGBA, swizzle.data());
 		}
-		else if (nbChannels == 3)
+
+		// Rows of 1 to 3 channel images are not 4-byte aligned
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(m_TextureID, 0, 0, 0, m_Width, m_Height, DataFormat(format), GL_UNSIGNED_BYTE, data);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glGenerateTextureMipmap(m_TextureID);
+
+		stbi_image_free(data);
+	}
+
+	void OpenGLTexture2D::loadContainer()
+	{
+		TextureData data;
+		if (!LoadTextureContainer(m_Path, data))
 		{
-			internalFormat = GL_RGB8;
-			dataFormat = GL_RGB;
+			Log::coreWarn("Invalid texture container");
+			return;
 		}
-		else
+		m_Loaded = true;
+		m_Width = static_cast<int32_t>(data.levels.front().width);
+		m_Height = static_cast<int32_t>(data.levels.front().height);
+		m_IsTransparent = TextureFormatHasAlpha(data.format);
+
+		// Precomputed chains are used as they are, blocks cannot be filtered down by the driver
+		const bool compressed = TextureFormatIsCompressed(data.format);
+		const bool generate = !compressed && data.levels.size() == 1;
+		createStorage(data.format, generate ? MipLevelCount(m_Width, m_Height) : static_cast<uint32_t>(data.levels.size()));
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (uint32_t level = 0; level < data.levels.size(); ++level)
 		{
-			cdCoreAssert(false, "Unsupported image format");
+			const auto& mip = data.levels[level];
+			const void* pixels = data.bytes.data() + mip.offset;
+			if (compressed)
+				glCompressedTextureSubImage2D(m_TextureID, level, 0, 0, mip.width, mip.height, InternalFormat(data.format), static_cast<GLsizei>(mip.size), pixels);
+			else
+				glTextureSubImage2D(m_TextureID, level, 0, 0, mip.width, mip.height, DataFormat(data.format), GL_UNSIGNED_BYTE, pixels);
 		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		if (generate)
+			glGenerateTextureMipmap(m_TextureID);
+	}
 
+	void OpenGLTexture2D::createStorage(TextureFormat format, uint32_t levels)
+	{
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureID);
-		glTextureStorage2D(m_TextureID, 1, internalFormat, m_Width, m_Height);
+		glTextureStorage2D(m_TextureID, static_cast<GLsizei>(levels), InternalFormat(format), m_Width, m_Height);
 
-		glTextureParameteri(m_TextureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_TextureID, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 		glTextureParameteri(m_TextureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 		glTextureParameteri(m_TextureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_TextureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-		glTextureSubImage2D(m_TextureID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
-
-		stbi_image_free(data);
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(int width, int height, void* data)
 		: m_Width(width), m_Height(height), m_TextureID()
 	{
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureID);
-		glTextureStorage2D(m_TextureID, 1, GL_RGBA8, m_Width, m_Height);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
+		createStorage(TextureFormat::RGBA8, 1);
 		glTextureSubImage2D(m_TextureID, 0, 0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, data);
 
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
+		OpenGLStateCache::forgetTexture(m_TextureID);
 		glDeleteTextures(1, &m_TextureID);
 	}
 
 	void OpenGLTexture2D::bind(int slot) const
 	{
-		glBindTextureUnit(slot, m_TextureID);
+		OpenGLStateCache::bindTextureUnit(slot, m_TextureID);
 	}
 
 	uint32_t OpenGLTexture2D::getRendererID()
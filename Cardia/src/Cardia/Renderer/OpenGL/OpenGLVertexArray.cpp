@@ -1,5 +1,6 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLVertexArray.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLStateCache.hpp"
 
 #include <glad/glad.h>
 
@@ -24,6 +25,15 @@ namespace Cardia
 				return GL_INT;
 			case ShaderDataType::Bool:
 				return GL_BOOL;
+			case ShaderDataType::Half:
+			case ShaderDataType::Half2:
+				return GL_HALF_FLOAT;
+			case ShaderDataType::Short4:
+				return GL_SHORT;
+			case ShaderDataType::UByte4:
+				return GL_UNSIGNED_BYTE;
+			case ShaderDataType::UShort:
+				return GL_UNSIGNED_SHORT;
 			default:
 				cdCoreAssert(false, "Unknown ShaderDataType.");
 				return 0;
@@ -37,40 +47,68 @@ namespace Cardia
 
 	void OpenGLVertexArray::bind() const
 	{
-		glBindVertexArray(m_VertexArrayID);
+		OpenGLStateCache::bindVertexArray(m_VertexArrayID);
 	}
 
 	void OpenGLVertexArray::unbind() const
 	{
-		glBindVertexArray(0);
+		OpenGLStateCache::bindVertexArray(0);
 	}
 
-	void OpenGLVertexArray::setVertexBuffer(std::unique_ptr<VertexBuffer> vertexBuffer)
+	uint32_t OpenGLVertexArray::bindLayout(const VertexBuffer& buffer, uint32_t firstIndex, uint32_t divisor) const
 	{
-		cdCoreAssert(vertexBuffer->getLayout().getElement().size(), "RectVertex Buffer should have a layout");
+		OpenGLStateCache::bindVertexArray(m_VertexArrayID);
+		buffer.bind();
 
-		glBindVertexArray(m_VertexArrayID);
-		vertexBuffer->bind();
-
-		uint32_t index = 0;
-		auto layout = vertexBuffer->getLayout();
+		uint32_t index = firstIndex;
+		const auto& layout = buffer.getLayout();
 		for (const auto& element : layout)
 		{
 			glEnableVertexAttribArray(index);
-			glVertexAttribPointer(index,
-								  element.getElementCount(),
-								  ShaderDataTypeToOpenGLType(element.type),
-								  element.normalized ? GL_TRUE : GL_FALSE,
-								  layout.getStride(),
-								  reinterpret_cast<const void*>(static_cast<int64_t>(element.offset)));
+			const auto offset = reinterpret_cast<const void*>(static_cast<int64_t>(element.offset));
+			if (ShaderDataTypeIsInteger(element.type) && !element.normalized)
+			{
+				glVertexAttribIPointer(index,
+						       element.getElementCount(),
+						       ShaderDataTypeToOpenGLType(element.type),
+						       layout.getStride(),
+						       offset);
+			}
+			else
+			{
+				glVertexAttribPointer(index,
+						      element.getElementCount(),
+						      ShaderDataTypeToOpenGLType(element.type),
+						      element.normalized ? GL_TRUE : GL_FALSE,
+						      layout.getStride(),
+						      offset);
+			}
+			glVertexAttribDivisor(index, divisor);
 			index++;
 		}
+		return index;
+	}
+
+	void OpenGLVertexArray::setVertexBuffer(std::unique_ptr<VertexBuffer> vertexBuffer)
+	{
+		cdCoreAssert(vertexBuffer->getLayout().getElement().size(), "RectVertex Buffer should have a layout");
+
+		m_VertexAttributeCount = bindLayout(*vertexBuffer, 0, 0);
 		m_VertexBuffer = std::move(vertexBuffer);
 	}
 
+	void OpenGLVertexArray::setInstanceBuffer(std::unique_ptr<VertexBuffer> instanceBuffer)
+	{
+		cdCoreAssert(m_VertexBuffer.get(), "Vertex buffer should be set before the instance buffer");
+		cdCoreAssert(instanceBuffer->getLayout().getElement().size(), "Instance Buffer should have a layout");
+
+		bindLayout(*instanceBuffer, m_VertexAttributeCount, 1);
+		m_InstanceBuffer = std::move(instanceBuffer);
+	}
+
 	void OpenGLVertexArray::setIndexBuffer(std::unique_ptr<IndexBuffer> indexBuffer)
 	{
-		glBindVertexArray(m_VertexArrayID);
+		OpenGLStateCache::bindVertexArray(m_VertexArrayID);
 		indexBuffer->bind();
 		m_IndexBuffer = std::move(indexBuffer);
 	}
@@ -84,4 +122,9 @@ namespace Cardia
 	{
 		return *m_IndexBuffer;
 	}
+
+	VertexBuffer& OpenGLVertexArray::getInstanceBuffer()
+	{
+		return *m_InstanceBuffer;
+	}
 }
\ No newline at end of file
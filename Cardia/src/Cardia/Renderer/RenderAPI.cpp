@@ -1,6 +1,7 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/RenderAPI.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLRenderAPI.hpp"
+#include "Cardia/Renderer/Null/NullRenderAPI.hpp"
 
 
 namespace Cardia
@@ -12,8 +13,7 @@ namespace Cardia
 		switch (s_API)
 		{
 		case API::None:
-			Log::coreError("{0} is not supported for the moment !", s_API);
-			cdCoreAssert(false, "Invalid API provided");
+			s_Instance = std::make_unique<NullRenderAPI>();
 			break;
 		case API::OpenGL:
 			s_Instance = std::make_unique<OpenGLRenderAPI>();
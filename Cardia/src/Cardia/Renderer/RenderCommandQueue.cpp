@@ -0,0 +1,51 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/RenderCommandQueue.hpp"
+
+
+namespace Cardia
+{
+	constexpr size_t commandBlockSize = 64 * 1024;
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		reset(false);
+	}
+
+	void RenderCommandQueue::execute()
+	{
+		reset(true);
+	}
+
+	void RenderCommandQueue::reset(bool run)
+	{
+		for (const auto& command : m_Commands)
+		{
+			command.invoke(command.payload, run);
+		}
+		m_Commands.clear();
+		m_BlockIndex = 0;
+		m_BlockCursor = 0;
+	}
+
+	void* RenderCommandQueue::allocate(size_t size, size_t alignment)
+	{
+		while (m_BlockIndex < m_Blocks.size())
+		{
+			auto& block = m_Blocks[m_BlockIndex];
+			const size_t offset = (m_BlockCursor + alignment - 1) / alignment * alignment;
+			if (offset + size <= block.size)
+			{
+				m_BlockCursor = offset + size;
+				return block.data.get() + offset;
+			}
+			m_BlockIndex++;
+			m_BlockCursor = 0;
+		}
+
+		const size_t blockSize = std::max(commandBlockSize, size);
+		m_Blocks.push_back({ std::make_unique<std::byte[]>(blockSize), blockSize });
+		m_BlockIndex = m_Blocks.size() - 1;
+		m_BlockCursor = size;
+		return m_Blocks.back().data.get();
+	}
+}
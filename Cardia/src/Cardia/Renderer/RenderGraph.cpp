@@ -0,0 +1,259 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/RenderGraph.hpp"
+#include "Cardia/Renderer/Renderer.hpp"
+#include "Cardia/Renderer/RenderThread.hpp"
+#include "Cardia/Renderer/OpenGL/OpenGLRenderGraphBackend.hpp"
+#include "Cardia/Renderer/Null/NullRenderGraphBackend.hpp"
+
+
+namespace Cardia
+{
+	constexpr uint32_t noSlot = ~0u;
+
+	std::unique_ptr<RenderGraphBackend> RenderGraphBackend::create()
+	{
+		RenderAPI::API& renderer = Renderer::getAPI();
+		switch (renderer)
+		{
+			case RenderAPI::API::None:
+				return std::make_unique<NullRenderGraphBackend>();
+			case RenderAPI::API::OpenGL:
+				return std::make_unique<OpenGLRenderGraphBackend>();
+			default:
+				Log::coreError("{0} is not supported for the moment !", renderer);
+				cdCoreAssert(false, "Invalid API provided");
+				return nullptr;
+		}
+	}
+
+	void RenderGraphFrame::acquire()
+	{
+		m_SlotTextures.resize(m_Slots.size());
+		for (size_t slot = 0; slot < m_Slots.size(); ++slot)
+			m_SlotTextures[slot] = m_Backend->acquireTexture(m_Slots[slot]);
+
+		for (size_t texture = 0; texture < m_TextureSlots.size(); ++texture)
+		{
+			if (m_TextureSlots[texture] != noSlot)
+				m_Textures[texture] = m_SlotTextures[m_TextureSlots[texture]];
+		}
+		// Resolved here, the framebuffer may have been resized since the frame was recorded
+		for (const auto& import : m_Imports)
+			m_Textures[import.texture] = import.framebuffer->GetColorAttachmentRendererID(import.attachmentIndex);
+	}
+
+	void RenderGraphFrame::beginPass(uint32_t pass)
+	{
+		const auto& commands = m_Passes[pass];
+		for (const auto access : commands.barriers)
+			m_Backend->barrier(access);
+		for (const auto texture : commands.clears)
+			m_Backend->clearTexture(m_Textures[texture], m_Descs[texture]);
+
+		if (commands.width == 0)
+			return;
+
+		std::vector<uint32_t> colors;
+		colors.reserve(commands.colors.size());
+		for (const auto texture : commands.colors)
+			colors.push_back(texture != invalidRenderGraphTexture ? m_Textures[texture] : 0);
+		const uint32_t depth = commands.depth != invalidRenderGraphTexture ? m_Textures[commands.depth] : 0;
+		m_Backend->beginPass(colors, depth, commands.width, commands.height);
+	}
+
+	void RenderGraphFrame::endPass()
+	{
+		m_Backend->endPass();
+	}
+
+	void RenderGraphFrame::release()
+	{
+		// Back to the backend pool, the next frame most likely gets the same textures
+		for (size_t slot = 0; slot < m_Slots.size(); ++slot)
+			m_Backend->releaseTexture(m_Slots[slot], m_SlotTextures[slot]);
+		m_SlotTextures.clear();
+	}
+
+	void RenderGraph::Builder::write(RenderGraphTexture texture, bool clear)
+	{
+		m_Graph.m_Passes[m_Pass].accesses.push_back({ texture, RenderGraphAccess::RenderTarget, true, clear });
+	}
+
+	void RenderGraph::Builder::writeLocal(RenderGraphTexture texture, bool clear)
+	{
+		m_Graph.m_Passes[m_Pass].accesses.push_back({ texture, RenderGraphAccess::RenderTarget, true, clear, true });
+	}
+
+	void RenderGraph::Builder::read(RenderGraphTexture texture, RenderGraphAccess access)
+	{
+		m_Graph.m_Passes[m_Pass].accesses.push_back({ texture, access, false, false });
+	}
+
+	void RenderGraph::Builder::sideEffect()
+	{
+		m_Graph.m_Passes[m_Pass].sideEffect = true;
+	}
+
+	RenderGraph::RenderGraph()
+		: m_Backend(RenderGraphBackend::create())
+	{
+	}
+
+	void RenderGraph::reset()
+	{
+		m_Textures.clear();
+		m_Passes.clear();
+	}
+
+	RenderGraphTexture RenderGraph::createTexture(std::string name, const RenderGraphTextureDesc& desc)
+	{
+		m_Textures.push_back({ std::move(name), desc });
+		return static_cast<RenderGraphTexture>(m_Textures.size() - 1);
+	}
+
+	RenderGraphTexture RenderGraph::importTexture(std::string name, const Framebuffer& framebuffer, uint32_t attachmentIndex, const RenderGraphTextureDesc& desc)
+	{
+		m_Textures.push_back({ std::move(name), desc, &framebuffer, attachmentIndex });
+		return static_cast<RenderGraphTexture>(m_Textures.size() - 1);
+	}
+
+	void RenderGraph::addPass(std::string name, const std::function<void(Builder&)>& setup, ExecuteFn execute)
+	{
+		m_Passes.push_back({ std::move(name), {}, std::move(execute) });
+		Builder builder(*this, static_cast<uint32_t>(m_Passes.size() - 1));
+		setup(builder);
+	}
+
+	std::shared_ptr<RenderGraphFrame> RenderGraph::compile(std::vector<uint32_t>& keptPasses)
+	{
+		// Walked from the end: a pass is kept when a kept pass reads what it writes, imports are always read.
+		// Depth and pass local attachments of a kept pass stay, so do the earlier contents it does not clear
+		std::vector<bool> needed(m_Textures.size());
+		for (size_t texture = 0; texture < m_Textures.size(); ++texture)
+			needed[texture] = m_Textures[texture].framebuffer != nullptr;
+
+		for (size_t pass = m_Passes.size(); pass-- > 0;)
+		{
+			const auto& node = m_Passes[pass];
+			const bool kept = node.sideEffect || std::ranges::any_of(node.accesses, [&](const TextureAccess& access) { return access.write && needed[access.texture]; });
+			if (!kept)
+				continue;
+
+			keptPasses.push_back(static_cast<uint32_t>(pass));
+			for (const auto& access : node.accesses)
+			{
+				const bool depth = m_Textures[access.texture].desc.format == FramebufferTextureFormat::DEPTH24STENCIL8;
+				if (!access.write || !access.clear || access.passLocal || depth)
+					needed[access.texture] = true;
+			}
+		}
+		std::ranges::reverse(keptPasses);
+
+		auto frame = std::make_shared<RenderGraphFrame>();
+		frame->m_Backend = m_Backend;
+		frame->m_Textures.resize(m_Textures.size());
+		frame->m_TextureSlots.assign(m_Textures.size(), noSlot);
+		for (size_t texture = 0; texture < m_Textures.size(); ++texture)
+		{
+			frame->m_Descs.push_back(m_Textures[texture].desc);
+			if (m_Textures[texture].framebuffer)
+				frame->m_Imports.push_back({ static_cast<RenderGraphTexture>(texture), m_Textures[texture].framebuffer, m_Textures[texture].attachmentIndex });
+		}
+
+		std::vector<uint32_t> lastUse(m_Textures.size());
+		for (uint32_t kept = 0; kept < keptPasses.size(); ++kept)
+		{
+			for (const auto& access : m_Passes[keptPasses[kept]].accesses)
+				lastUse[access.texture] = kept;
+		}
+
+		// A slot freed after the last use of a texture is taken by the next one with the same description
+		std::vector<uint32_t> freeSlots;
+		std::vector<bool> written(m_Textures.size());
+		for (uint32_t kept = 0; kept < keptPasses.size(); ++kept)
+		{
+			const auto& node = m_Passes[keptPasses[kept]];
+			RenderGraphFrame::PassCommands commands;
+
+			for (const auto& access : node.accesses)
+			{
+				const auto& texture = m_Textures[access.texture];
+				const bool depth = texture.desc.format == FramebufferTextureFormat::DEPTH24STENCIL8;
+				if (!needed[access.texture])
+				{
+					// Culled output, its location stays so the shaders still match the attachments
+					if (!depth)
+						commands.colors.push_back(invalidRenderGraphTexture);
+					continue;
+				}
+
+				auto& slot = frame->m_TextureSlots[access.texture];
+				if (!texture.framebuffer && slot == noSlot)
+				{
+					const auto alias = std::ranges::find_if(freeSlots, [&](uint32_t free) { return frame->m_Slots[free].isAliasOf(texture.desc); });
+					if (alias != freeSlots.end())
+					{
+						slot = *alias;
+						freeSlots.erase(alias);
+					}
+					else
+					{
+						slot = static_cast<uint32_t>(frame->m_Slots.size());
+						frame->m_Slots.push_back(texture.desc);
+					}
+				}
+
+				if (!access.write)
+				{
+					if (written[access.texture] && std::ranges::find(commands.barriers, access.access) == commands.barriers.end())
+						commands.barriers.push_back(access.access);
+					continue;
+				}
+
+				if (depth)
+					commands.depth = access.texture;
+				else
+					commands.colors.push_back(access.texture);
+				if (access.clear)
+					commands.clears.push_back(access.texture);
+				if (commands.width == 0)
+				{
+					commands.width = texture.desc.width;
+					commands.height = texture.desc.height;
+				}
+			}
+
+			for (const auto& access : node.accesses)
+			{
+				if (access.write)
+					written[access.texture] = true;
+			}
+			for (size_t texture = 0; texture < m_Textures.size(); ++texture)
+			{
+				if (frame->m_TextureSlots[texture] != noSlot && lastUse[texture] == kept)
+					freeSlots.push_back(frame->m_TextureSlots[texture]);
+			}
+			frame->m_Passes.push_back(std::move(commands));
+		}
+		return frame;
+	}
+
+	void RenderGraph::execute()
+	{
+		std::vector<uint32_t> keptPasses;
+		const auto frame = compile(keptPasses);
+		m_KeptPassCount = static_cast<uint32_t>(keptPasses.size());
+		m_PhysicalTextureCount = static_cast<uint32_t>(frame->m_Slots.size());
+
+		RenderThread::submit([frame] { frame->acquire(); });
+		for (uint32_t pass = 0; pass < keptPasses.size(); ++pass)
+		{
+			RenderThread::submit([frame, pass] { frame->beginPass(pass); });
+			if (const auto& execute = m_Passes[keptPasses[pass]].execute)
+				execute(frame);
+			if (frame->m_Passes[pass].width != 0)
+				RenderThread::submit([frame] { frame->endPass(); });
+		}
+		RenderThread::submit([frame] { frame->release(); });
+	}
+}
@@ -0,0 +1,131 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/RenderThread.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace Cardia
+{
+	struct RenderThreadData
+	{
+		RendererContext* context = nullptr;
+		std::array<RenderCommandQueue, 2> queues;
+		uint32_t submitQueue = 0;
+
+		bool threaded = false;
+		bool running = false;
+		bool frameKicked = false;
+		bool ownsContext = true; // Whether the front end thread currently has the context
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+
+	static std::unique_ptr<RenderThreadData> s_Data {};
+
+	void RenderThread::init(RendererContext& context, bool threaded)
+	{
+		s_Data = std::make_unique<RenderThreadData>();
+		s_Data->context = &context;
+		setThreaded(threaded);
+	}
+
+	void RenderThread::quit()
+	{
+		setThreaded(false);
+		s_Data.reset();
+	}
+
+	RenderCommandQueue& RenderThread::getSubmitQueue()
+	{
+		return s_Data->queues[s_Data->submitQueue];
+	}
+
+	void RenderThread::kick()
+	{
+		if (!s_Data->threaded)
+			return;
+
+		sync();
+		s_Data->context->releaseCurrent();
+		s_Data->ownsContext = false;
+		{
+			std::lock_guard lock(s_Data->mutex);
+			s_Data->submitQueue = 1 - s_Data->submitQueue;
+			s_Data->frameKicked = true;
+		}
+		s_Data->condition.notify_all();
+	}
+
+	void RenderThread::sync()
+	{
+		if (!s_Data->threaded)
+		{
+			getSubmitQueue().execute();
+			return;
+		}
+
+		{
+			std::unique_lock lock(s_Data->mutex);
+			s_Data->condition.wait(lock, [] { return !s_Data->frameKicked; });
+		}
+		if (!s_Data->ownsContext)
+		{
+			s_Data->context->makeCurrent();
+			s_Data->ownsContext = true;
+		}
+	}
+
+	void RenderThread::run()
+	{
+		std::unique_lock lock(s_Data->mutex);
+		while (true)
+		{
+			s_Data->condition.wait(lock, [] { return s_Data->frameKicked || !s_Data->running; });
+			if (!s_Data->frameKicked)
+				break;
+
+			auto& queue = s_Data->queues[1 - s_Data->submitQueue];
+			lock.unlock();
+
+			s_Data->context->makeCurrent();
+			queue.execute();
+			s_Data->context->releaseCurrent();
+
+			lock.lock();
+			s_Data->frameKicked = false;
+			s_Data->condition.notify_all();
+		}
+	}
+
+	void RenderThread::setThreaded(bool state)
+	{
+		if (state == s_Data->threaded)
+			return;
+
+		if (state)
+		{
+			s_Data->running = true;
+			s_Data->threaded = true;
+			s_Data->thread = std::thread(&RenderThread::run);
+			return;
+		}
+
+		sync();
+		{
+			std::lock_guard lock(s_Data->mutex);
+			s_Data->running = false;
+		}
+		s_Data->condition.notify_all();
+		s_Data->thread.join();
+		s_Data->threaded = false;
+	}
+
+	bool RenderThread::isThreaded()
+	{
+		return s_Data->threaded;
+	}
+}
@@ -4,9 +4,19 @@
 #include "Cardia/Renderer/RenderAPI.hpp"
 #include "Cardia/Renderer/Shader.hpp"
 #include "Cardia/Renderer/Batch.hpp"
+#include "Cardia/Renderer/RenderThread.hpp"
+#include "Cardia/Renderer/MeshRenderer.hpp"
+#include "Cardia/Renderer/StaticMeshPool.hpp"
+#include "Cardia/Renderer/ClusteredLights.hpp"
+#include "Cardia/Renderer/RetainedSprites.hpp"
+#include "Cardia/Renderer/GpuProfiler.hpp"
+#include "Cardia/DataStructure/RadixSort.hpp"
+#include "Cardia/DataStructure/Bounds.hpp"
 
 #include <glm/ext/matrix_transform.hpp>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <glm/gtx/quaternion.hpp>
@@ -16,92 +26,643 @@ namespace Cardia
 
 	static std::unique_ptr<Renderer2D::Stats> s_Stats;
 
-	struct LightData
+	// std140 layout of the FrameData block shared by every scene shader
+	struct FrameUniforms
 	{
-		glm::vec4 positionAndType {};
-		glm::vec4 directionAndRange {};
-		glm::vec4 colorAndCutOff {};
+		glm::mat4 viewProjection;
+		glm::mat4 view;
+		glm::vec4 viewPosition;
+		glm::vec4 clusterDepth;
+		glm::ivec4 lightCounts; // x: all lights, y: directional lights
 	};
+	static_assert(sizeof(FrameUniforms) == 176, "FrameUniforms must match its std140 layout");
+	constexpr int frameUniformBinding = 0;
 
-	struct Renderer2DData
+	// Pooled meshes always carry a texture index and can have transparent texels
+	constexpr ShaderFeatures meshShaderFeatures = ShaderFeature::Textured | ShaderFeature::Lit | ShaderFeature::AlphaTested;
+
+	// A batch fills at most one streaming region: uploading this many batches in a row moves on to at most
+	// every other region once, nothing is overwritten before it is drawn
+	constexpr size_t prePassChunkBatches = streamingBufferRegions - 1;
+
+	// Indirect command slots of GPU culled sprite batches, recycled once every ring region moved on
+	constexpr uint32_t maxCulledSpriteBatches = 256 * streamingBufferRegions;
+
+	// drawRect call kept until endScene in top-down mode, sprites are then submitted sorted across batches
+	struct TopDownSprite
+	{
+		glm::mat4 transform;
+		const Texture2D* texture;
+		glm::vec4 color;
+		glm::vec4 uvRect;
+		float tilingFactor;
+		int32_t zIndex;
+		int32_t entityID;
+	};
+
+	struct MeshSubmission
+	{
+		std::shared_ptr<MeshRenderer> meshRenderer;
+		glm::mat4 transform;
+		int32_t entityID;
+	};
+
+	// Everything the back end needs to replay a scene, moved out of the front end by endScene
+	struct SceneFrame
 	{
 		std::vector<Batch> batches;
+		std::vector<MeshSubmission> meshes;
+		RetainedSpriteFrame retainedSprites;
+		std::vector<LightData> lights;
 		glm::vec3 cameraPosition {};
-		std::unique_ptr<Shader> basicShader;
+		glm::mat4 viewMatrix {};
+		glm::mat4 projectionMatrix {};
 		glm::mat4 viewProjectionMatrix {};
+		bool topDownSorting = false;
+		bool gpuCulling = false;
+		bool depthPrePass = false;
+		int culledCount = 0;
+	};
 
-		std::unique_ptr<VertexArray> vertexArray;
-		std::unique_ptr<StorageBuffer> lightStorageBuffer;
+	struct Renderer2DData
+	{
+		// Front end, recorded between beginScene and endScene
+		std::vector<Batch> batches;
+		std::unordered_map<uint64_t, size_t> openBatches; // BatchSpecification key -> index of the batch still accepting meshes
+		std::vector<MeshSubmission> meshes;
+		std::vector<TopDownSprite> topDownSprites;
+		std::vector<SortItem> topDownOrder;
+		std::vector<SortItem> topDownOrderScratch;
+		RetainedSpriteFrame retainedSprites;
+		std::optional<uint32_t> retainedSpritesOwner; // RetainedSprites whose content is in the retained buffer
+
+		glm::vec3 cameraPosition {};
+		glm::mat4 viewMatrix {};
+		glm::mat4 projectionMatrix {};
+		glm::mat4 viewProjectionMatrix {};
 		std::vector<LightData> lightDataBuffer;
+		int culledCount = 0;
+		bool depthPrePass = false; // Of the camera the scene began with
+		bool topDownScene = false; // topDownSorting when the scene began
+
+		bool instancedSprites = true;
+		bool topDownSorting = false;
+		bool gpuCulling = false;
+		bool retainSprites = true;
+
+		// Back end, only touched while replaying a scene
+		std::vector<SortItem> batchOrder;
+		std::vector<SortItem> batchOrderScratch;
+		std::unique_ptr<ClusteredLights> clusteredLights;
+		std::unique_ptr<UniformBuffer> frameUniformBuffer;
+		std::unique_ptr<Shader> spriteCullShader;
+		std::unique_ptr<VertexArray> culledSpriteVertexArray;
+		std::unique_ptr<IndirectBuffer> spriteCullCommands;
+		std::unique_ptr<IndirectBuffer> spriteCullGroupCounts;
+		uint32_t spriteCullSlot {};
+
+		std::unique_ptr<ShaderVariants> batchShaders; // Sprites are its Instanced variants
+		std::unique_ptr<ShaderVariants> meshShaders;
 
+		std::unique_ptr<VertexArray> vertexArray;
+		std::unique_ptr<VertexArray> spriteVertexArray;
+		std::unique_ptr<VertexArray> retainedSpriteVertexArray;
+		std::unique_ptr<Texture2D> whiteTexture;
 	};
 
 	static std::unique_ptr<Renderer2DData> s_Data {};
 
+	// One upload per frame, every shader declaring the FrameData block sees it
+	static void UploadFrameUniforms(const SceneFrame& frame)
+	{
+		const auto& lights = *s_Data->clusteredLights;
+		FrameUniforms uniforms {};
+		uniforms.viewProjection = frame.viewProjectionMatrix;
+		uniforms.view = frame.viewMatrix;
+		uniforms.viewPosition = glm::vec4(frame.cameraPosition, 1.0f);
+		uniforms.clusterDepth = lights.getDepthParameters();
+		uniforms.lightCounts = glm::ivec4(lights.getLightCount(), lights.getDirectionalLightCount(), 0, 0);
+
+		s_Data->frameUniformBuffer->setData(&uniforms, sizeof(FrameUniforms));
+		s_Data->frameUniformBuffer->bind(frameUniformBinding);
+	}
+
+	// Unit quad drawn once per instance of instanceBuffer
+	static std::unique_ptr<VertexArray> CreateSpriteVertexArray(std::unique_ptr<VertexBuffer> instanceBuffer)
+	{
+		auto vertexArray = VertexArray::create();
+
+		constexpr float quadVertices[] {
+			-0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
+			 0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
+			 0.5f,  0.5f, 0.0f, 1.0f, 1.0f,
+			-0.5f,  0.5f, 0.0f, 0.0f, 1.0f
+		};
+		std::unique_ptr<VertexBuffer> quadVbo = VertexBuffer::create(quadVertices, sizeof(quadVertices));
+		quadVbo->setLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::Float2, "a_TexPos"}
+		});
+		vertexArray->setVertexBuffer(std::move(quadVbo));
+
+		uint32_t quadIndices[] { 0, 1, 2, 2, 3, 0 };
+		vertexArray->setIndexBuffer(IndexBuffer::create(quadIndices, 6));
+
+		static_assert(sizeof(SpriteInstance) == 23 * sizeof(float), "SpriteInstance must match its buffer layout");
+		instanceBuffer->setLayout({
+			{ShaderDataType::Float4, "a_TransformRow0"},
+			{ShaderDataType::Float4, "a_TransformRow1"},
+			{ShaderDataType::Float4, "a_TransformRow2"},
+			{ShaderDataType::Float4, "a_Color"},
+			{ShaderDataType::Float4, "a_UVRect"},
+			{ShaderDataType::Float, "a_TilingFactor"},
+			{ShaderDataType::Int, "a_EntityID"},
+			{ShaderDataType::Int, "a_TextureIndex"}
+		});
+		vertexArray->setInstanceBuffer(std::move(instanceBuffer));
+		return vertexArray;
+	}
+
+	template<typename AddFn>
+	static void SubmitToBatch(const BatchSpecification& specification, const AddFn& add)
+	{
+		// Top-down sprites arrive sorted, a batch may only grow while it is the last one
+		if (s_Data->topDownScene)
+		{
+			auto& batches = s_Data->batches;
+			if (!batches.empty() && batches.back().specification == specification && add(batches.back()))
+				return;
+			VertexArray* vertexArray = specification.isInstanced() ? s_Data->spriteVertexArray.get() : s_Data->vertexArray.get();
+			add(batches.emplace_back(vertexArray, s_Data->cameraPosition, s_Data->whiteTexture.get(), specification));
+			return;
+		}
+
+		const uint64_t key = specification.key();
+		const auto openBatch = s_Data->openBatches.find(key);
+		if (openBatch != s_Data->openBatches.end() && add(s_Data->batches[openBatch->second]))
+			return;
+
+		VertexArray* vertexArray = specification.isInstanced() ? s_Data->spriteVertexArray.get() : s_Data->vertexArray.get();
+		s_Data->openBatches.insert_or_assign(key, s_Data->batches.size());
+		auto& batch = s_Data->batches.emplace_back(vertexArray, s_Data->cameraPosition, s_Data->whiteTexture.get(), specification);
+		add(batch);
+	}
+
+	static void SubmitRect(const glm::mat4& transform, const Texture2D* texture, const glm::vec4& color, float tilingFactor, int32_t zIndex, int32_t entityID, const glm::vec4& uvRect)
+	{
+		const BatchSpecification specification = MakeSpriteSpecification(texture, color, zIndex, s_Data->instancedSprites);
+		if (specification.isInstanced())
+		{
+			const SpriteInstance sprite = MakeSpriteInstance(transform, color, uvRect, tilingFactor, entityID);
+			SubmitToBatch(specification, [&](Batch& batch) { return batch.addSprite(sprite, texture); });
+			return;
+		}
+
+		constexpr glm::vec2 texCoords[] {
+			{ 0.0f, 0.0f },
+			{ 1.0f, 0.0f },
+			{ 1.0f, 1.0f },
+			{ 0.0f, 1.0f }
+		};
+
+		constexpr glm::vec4 rectPositions[]
+		{
+			{ -0.5f, -0.5f, 0.0f, 1.0f },
+			{  0.5f, -0.5f, 0.0f, 1.0f },
+			{  0.5f,  0.5f, 0.0f, 1.0f },
+			{ -0.5f,  0.5f, 0.0f, 1.0f },
+		};
+		constexpr glm::vec4 normal { 0.0f, 0.0f, 1.0f, 0.0f };
+
+		SubMesh mesh;
+		const auto finalNormal = glm::mat3(glm::transpose(glm::inverse(transform))) * normal;
+		for (int i = 0; i < sizeof(rectPositions) / sizeof(glm::vec4); ++i)
+		{
+			auto vertex = Vertex();
+			vertex.position = transform * rectPositions[i];
+			vertex.normal = finalNormal;
+			vertex.color = color;
+			vertex.textureCoord = glm::vec2(uvRect) + texCoords[i % 4] * glm::vec2(uvRect.z, uvRect.w);
+			vertex.tilingFactor = tilingFactor;
+			vertex.entityID = entityID;
+			mesh.GetVertices().push_back(vertex);
+		}
+
+		mesh.GetIndices() = std::vector<uint32_t>({ 0, 1, 2, 2, 3, 0 });
+
+		SubmitToBatch(specification, [&](Batch& batch) { return batch.addMesh(&mesh, texture); });
+	}
+
+	// Layer first, then highest on the Y axis, whatever batch a sprite lands in
+	static void SubmitTopDownSprites()
+	{
+		auto& sprites = s_Data->topDownSprites;
+		auto& order = s_Data->topDownOrder;
+		order.clear();
+		for (uint32_t index = 0; index < sprites.size(); ++index)
+		{
+			const auto& sprite = sprites[index];
+			const uint64_t layerKey = static_cast<uint32_t>(sprite.zIndex) ^ 0x80000000u;
+			order.push_back({ layerKey << 32 | ~FloatSortKey(sprite.transform[3].y), index });
+		}
+		RadixSort(order, s_Data->topDownOrderScratch);
+
+		for (const auto& item : order)
+		{
+			const auto& sprite = sprites[item.index];
+			SubmitRect(sprite.transform, sprite.texture, sprite.color, sprite.tilingFactor, sprite.zIndex, sprite.entityID, sprite.uvRect);
+		}
+		sprites.clear();
+	}
+
+	// Writes the instances changed since the last frame in place, the rest of the buffer is kept
+	static void UploadRetainedSprites(const RetainedSpriteFrame& retained)
+	{
+		auto& instanceBuffer = s_Data->retainedSpriteVertexArray->getInstanceBuffer();
+		const SpriteInstance* data = retained.uploadData.data();
+		for (const auto& upload : retained.uploads)
+		{
+			instanceBuffer.setData(data, upload.instanceCount * sizeof(SpriteInstance), upload.firstInstance * sizeof(SpriteInstance));
+			data += upload.instanceCount;
+		}
+	}
+
+	// Variant laying the depth of an opaque draw: nothing is lit, textures are only sampled for the alpha test
+	static ShaderFeatures DepthPrePassFeatures(ShaderFeatures features)
+	{
+		features &= static_cast<ShaderFeatures>(~ShaderFeature::Lit);
+		if (!(features & ShaderFeature::AlphaTested))
+			features &= static_cast<ShaderFeatures>(~ShaderFeature::Textured);
+		return features;
+	}
+
+	static void DrawRetainedSprites(const RetainedSpriteDraw& draw, Shader& shader)
+	{
+		shader.bind();
+		s_Data->whiteTexture->bind(0);
+		if (draw.texture)
+			draw.texture->bind(1);
+
+		s_Data->retainedSpriteVertexArray->bind();
+		RenderAPI::get().drawIndexedInstanced(s_Data->retainedSpriteVertexArray.get(), draw.instanceCount, draw.firstInstance);
+	}
+
+	// Back end of endScene, runs wherever the render thread replays the frame
+	static void RenderScene(SceneFrame& frame)
+	{
+		auto& stats = Renderer2D::getStats();
+		stats.drawCalls = 0;
+		stats.triangleCount = 0;
+		stats.culledCount = frame.culledCount;
+		RenderAPI::get().resetStateCounters();
+
+		auto& profiler = GpuProfiler::get();
+		profiler.begin(GpuPass::LightsUpload);
+		s_Data->clusteredLights->update(frame.lights, frame.viewMatrix, frame.projectionMatrix);
+		s_Data->clusteredLights->bind();
+
+		UploadFrameUniforms(frame);
+		profiler.end(GpuPass::LightsUpload);
+
+		// Sprites are drawn unculled until the cull shader is compiled
+		const Frustum frustum(frame.viewProjectionMatrix);
+		const bool cullSprites = frame.gpuCulling && s_Data->spriteCullShader->isReady();
+		if (cullSprites)
+		{
+			s_Data->spriteCullShader->bind();
+			const auto& planes = frustum.GetPlanes();
+			s_Data->spriteCullShader->setFloat4Array("u_FrustumPlanes", planes.data(), static_cast<int>(planes.size()));
+		}
+
+		profiler.begin(GpuPass::Sprites);
+		UploadRetainedSprites(frame.retainedSprites);
+
+		// Batch keys already encode the draw order, the batches themselves stay in place.
+		// Retained sprite groups are interleaved with them, indexed after the batches.
+		// Top-down batches were created in layer then Y order, they keep it inside their layer.
+		const bool depthPrePass = frame.depthPrePass && !frame.topDownSorting;
+		const auto batchCount = static_cast<uint32_t>(frame.batches.size());
+		const auto& retainedDraws = frame.retainedSprites.draws;
+		s_Data->batchOrder.clear();
+		for (uint32_t index = 0; index < batchCount; ++index)
+		{
+			const uint64_t key = frame.topDownSorting
+				? (frame.batches[index].specification.key() & 0xffffffff00000000ull) | index
+				: frame.batches[index].drawKey(depthPrePass);
+			s_Data->batchOrder.push_back({ key, index });
+		}
+		for (uint32_t index = 0; index < retainedDraws.size(); ++index)
+		{
+			s_Data->batchOrder.push_back({ retainedDraws[index].specification.key(), batchCount + index });
+		}
+		RadixSort(s_Data->batchOrder, s_Data->batchOrderScratch);
+
+		// Uploads a batch right before its draws, retained groups are already in their buffer
+		const auto prepareItem = [&](const SortItem& item)
+		{
+			if (item.index >= batchCount)
+				return;
+
+			auto& batch = frame.batches[item.index];
+			// Top-down sprites were sorted across batches by endScene, they are uploaded as submitted
+			BatchOrder order = BatchOrder::Submission;
+			if (!frame.topDownSorting && batch.specification.alpha)
+				order = BatchOrder::BackToFront;
+			else if (depthPrePass)
+				order = BatchOrder::FrontToBack;
+
+			if (cullSprites && batch.specification.isInstanced())
+			{
+				const SpriteCulling culling {
+					s_Data->spriteCullShader.get(),
+					s_Data->culledSpriteVertexArray.get(),
+					s_Data->spriteCullCommands.get(),
+					s_Data->spriteCullGroupCounts.get(),
+					s_Data->spriteCullSlot
+				};
+				s_Data->spriteCullSlot = (s_Data->spriteCullSlot + 1) % maxCulledSpriteBatches;
+				batch.prepare(order, &culling);
+			}
+			else
+			{
+				batch.prepare(order);
+			}
+		};
+		// Everything uploaded so far has been drawn, the ring regions holding it may be reused once the GPU is done
+		const auto fenceUploads = [&]()
+		{
+			s_Data->vertexArray->getVertexBuffer().fence();
+			s_Data->vertexArray->getIndexBuffer().fence();
+			s_Data->spriteVertexArray->getInstanceBuffer().fence();
+		};
+
+		const auto specificationOf = [&](const SortItem& item) -> const BatchSpecification&
+		{
+			return item.index >= batchCount ? retainedDraws[item.index - batchCount].specification : frame.batches[item.index].specification;
+		};
+		// Variants still compiling in the background are skipped until they are done, instead of stalling the frame
+		const auto isReady = [&](const BatchSpecification& specification)
+		{
+			const bool prePass = depthPrePass && !specification.alpha;
+			return s_Data->batchShaders->get(specification.shaderFeatures).isReady()
+				&& (!prePass || s_Data->batchShaders->get(DepthPrePassFeatures(specification.shaderFeatures)).isReady());
+		};
+		const auto drawItem = [&](const SortItem& item, bool depthOnly)
+		{
+			const auto& specification = specificationOf(item);
+			if (!isReady(specification))
+				return;
+			const ShaderFeatures features = depthOnly ? DepthPrePassFeatures(specification.shaderFeatures) : specification.shaderFeatures;
+			Shader& shader = s_Data->batchShaders->get(features);
+			if (item.index >= batchCount)
+			{
+				const auto& draw = retainedDraws[item.index - batchCount];
+				DrawRetainedSprites(draw, shader);
+				stats.triangleCount += static_cast<int>(draw.instanceCount * 2);
+			}
+			else
+			{
+				const auto& batch = frame.batches[item.index];
+				batch.draw(shader);
+				stats.triangleCount += static_cast<int>(batch.getTriangleCount());
+			}
+			stats.drawCalls++;
+		};
+
+		// Top-down sprites usually share the same depth, the Y order is what decides overlapping
+		if (frame.topDownSorting)
+			RenderAPI::get().disableDepth();
+
+		// Layer by layer, opaque draws come before translucent ones inside a layer
+		const auto& batchOrder = s_Data->batchOrder;
+		for (size_t layerBegin = 0; layerBegin < batchOrder.size();)
+		{
+			const int32_t layer = specificationOf(batchOrder[layerBegin]).layer;
+			size_t opaqueEnd = layerBegin;
+			while (opaqueEnd < batchOrder.size() && specificationOf(batchOrder[opaqueEnd]).layer == layer && !specificationOf(batchOrder[opaqueEnd]).alpha)
+				++opaqueEnd;
+			size_t layerEnd = opaqueEnd;
+			while (layerEnd < batchOrder.size() && specificationOf(batchOrder[layerEnd]).layer == layer)
+				++layerEnd;
+
+			RenderAPI::get().clearDepthBuffer();
+
+			// Opaque depth first, shading then only runs for the fragments that ended up visible.
+			// The pre-pass draws every batch twice, it runs on chunks small enough for their uploads to never wrap the rings.
+			if (depthPrePass)
+			{
+				for (size_t chunkBegin = layerBegin; chunkBegin < opaqueEnd;)
+				{
+					const size_t chunkEnd = std::min(opaqueEnd, chunkBegin + prePassChunkBatches);
+					for (size_t index = chunkBegin; index < chunkEnd; ++index)
+						prepareItem(batchOrder[index]);
+
+					RenderAPI::get().setColorWrite(false);
+					for (size_t index = chunkBegin; index < chunkEnd; ++index)
+						drawItem(batchOrder[index], true);
+					RenderAPI::get().setColorWrite(true);
+					RenderAPI::get().setDepthWrite(false);
+					RenderAPI::get().setDepthFunction(RenderAPI::DepthFunction::Equal);
+
+					for (size_t index = chunkBegin; index < chunkEnd; ++index)
+						drawItem(batchOrder[index], false);
+
+					RenderAPI::get().setDepthWrite(true);
+					RenderAPI::get().setDepthFunction(RenderAPI::DepthFunction::Less);
+					fenceUploads();
+					chunkBegin = chunkEnd;
+				}
+			}
+			else
+			{
+				for (size_t index = layerBegin; index < opaqueEnd; ++index)
+				{
+					prepareItem(batchOrder[index]);
+					drawItem(batchOrder[index], false);
+					fenceUploads();
+				}
+			}
+
+			for (size_t index = opaqueEnd; index < layerEnd; ++index)
+			{
+				prepareItem(batchOrder[index]);
+				drawItem(batchOrder[index], false);
+				fenceUploads();
+			}
+
+			layerBegin = layerEnd;
+		}
+
+		if (frame.topDownSorting)
+			RenderAPI::get().enableDepth();
+		profiler.end(GpuPass::Sprites);
+
+		profiler.begin(GpuPass::Meshes);
+		for (const auto& mesh : frame.meshes)
+		{
+			mesh.meshRenderer->Submit(mesh.transform, mesh.entityID);
+		}
+		std::optional<MeshDepthPrePass> meshDepthPrePass;
+		Shader& meshDepthShader = s_Data->meshShaders->get(DepthPrePassFeatures(meshShaderFeatures));
+		if (frame.depthPrePass && meshDepthShader.isReady())
+			meshDepthPrePass = MeshDepthPrePass { &meshDepthShader, frame.cameraPosition };
+		StaticMeshPool::flush(s_Data->meshShaders->get(meshShaderFeatures), frame.gpuCulling ? &frustum : nullptr, meshDepthPrePass ? &*meshDepthPrePass : nullptr);
+		profiler.end(GpuPass::Meshes);
+
+		const auto stateCounters = RenderAPI::get().getStateCounters();
+		stats.stateChanges = static_cast<int>(stateCounters.issued);
+		stats.elidedStateChanges = static_cast<int>(stateCounters.elided);
+
+		s_Data->vertexArray->getVertexBuffer().nextFrame();
+		s_Data->vertexArray->getIndexBuffer().nextFrame();
+		s_Data->spriteVertexArray->getInstanceBuffer().nextFrame();
+	}
+
 	void Renderer2D::init()
 	{
 		s_Data = std::make_unique<Renderer2DData>();
 		s_Stats = std::make_unique<Renderer2D::Stats>();
-		s_Data->basicShader = Shader::create({"resources/shaders/basic.vert", "resources/shaders/basic.frag"});
 		s_Data->batches.clear();
+		s_Data->openBatches.clear();
 		s_Data->lightDataBuffer.clear();
+		// Variants are compiled by the back end the first time a batch asks for them
+		s_Data->batchShaders = std::make_unique<ShaderVariants>(std::vector<std::string>{"resources/shaders/basic.vert", "resources/shaders/basic.frag"});
 		s_Data->vertexArray = VertexArray::create();
 
-		std::unique_ptr<VertexBuffer> vbo = VertexBuffer::create(maxVertices * sizeof(Vertex));
+		uint32_t whiteColor = 0xffffffff;
+		s_Data->whiteTexture = Texture2D::create(1, 1, &whiteColor);
 
-		vbo->setLayout({
-			{ShaderDataType::Float3, "a_Position"},
-			{ShaderDataType::Float3, "a_Normal"},
-			{ShaderDataType::Float4, "a_Color"},
-			{ShaderDataType::Float2, "a_TexPos"},
-			{ShaderDataType::Float, "a_TilingFactor"},
-			{ShaderDataType::Float, "a_EntityID"}
-		});
+		// Queried while the context is current, batches are later created by the front end without it
+		RenderAPI::get().getMaxTextureSlots();
+
+		// Streaming regions hold one full batch, they are reused as soon as the batches in them are drawn
+		std::unique_ptr<VertexBuffer> vbo = VertexBuffer::createStreaming(maxVertices * sizeof(Vertex));
+
+		vbo->setLayout(GetVertexLayout(VertexFormat::Standard));
 
 		s_Data->vertexArray->setVertexBuffer(std::move(vbo));
 
-		std::unique_ptr<IndexBuffer> ibo = IndexBuffer::create(maxIndices);
+		std::unique_ptr<IndexBuffer> ibo = IndexBuffer::createStreaming(maxIndices);
 		s_Data->vertexArray->setIndexBuffer(std::move(ibo));
+
+		// Instanced sprites: one static unit quad, everything else comes from the instance buffer
+		s_Data->spriteVertexArray = CreateSpriteVertexArray(VertexBuffer::createStreaming(maxSpriteInstances * sizeof(SpriteInstance)));
+		s_Data->retainedSpriteVertexArray = CreateSpriteVertexArray(VertexBuffer::create(maxRetainedSprites * sizeof(SpriteInstance)));
+
+		// GPU culling: visible sprites are compacted at the same offsets as the whole streaming ring
+		s_Data->spriteCullShader = Shader::create({"resources/shaders/sprite_cull.comp"});
+		s_Data->culledSpriteVertexArray = CreateSpriteVertexArray(VertexBuffer::create(streamingBufferRegions * maxSpriteInstances * sizeof(SpriteInstance)));
+		s_Data->spriteCullCommands = IndirectBuffer::create(maxCulledSpriteBatches * sizeof(DrawElementsIndirectCommand));
+		s_Data->spriteCullGroupCounts = IndirectBuffer::create(maxSpriteCullGroups * sizeof(uint32_t));
+
+		s_Data->clusteredLights = std::make_unique<ClusteredLights>();
+		s_Data->frameUniformBuffer = UniformBuffer::create(sizeof(FrameUniforms));
+
+		// Static meshes: pooled geometry, transforms come from a per-draw storage buffer
+		StaticMeshPool::init();
+		s_Data->meshShaders = std::make_unique<ShaderVariants>(std::vector<std::string>{"resources/shaders/mesh.vert", "resources/shaders/basic.frag"});
 	}
 
 	void Renderer2D::quit()
 	{
 		s_Data.reset();
+		StaticMeshPool::quit();
 	}
 
 	void Renderer2D::beginScene(Camera& camera, const glm::mat4& transform)
 	{
 		s_Data->batches.clear();
+		s_Data->openBatches.clear();
+		s_Data->meshes.clear();
 		s_Data->lightDataBuffer.clear();
 		s_Data->cameraPosition = glm::vec3(transform[3]);
-		s_Data->basicShader->setMat4("u_ViewProjection", camera.getProjectionMatrix() * glm::inverse(transform));
-		s_Data->basicShader->setFloat3("u_ViewPosition", s_Data->cameraPosition);
-		s_Data->viewProjectionMatrix = camera.getProjectionMatrix() * glm::inverse(transform);
-		s_Stats->drawCalls = 0;
-		s_Stats->triangleCount = 0;
+		s_Data->viewMatrix = glm::inverse(transform);
+		s_Data->projectionMatrix = camera.getProjectionMatrix();
+		s_Data->viewProjectionMatrix = s_Data->projectionMatrix * s_Data->viewMatrix;
+		s_Data->culledCount = 0;
+		s_Data->depthPrePass = camera.isDepthPrePass();
+		s_Data->topDownScene = s_Data->topDownSorting;
+		s_Data->topDownSprites.clear();
 	}
 
 	void Renderer2D::endScene()
 	{
-		s_Data->lightStorageBuffer = StorageBuffer::create(s_Data->lightDataBuffer.size() * sizeof(LightData));
-		s_Data->lightStorageBuffer->setData(s_Data->lightDataBuffer.data(), s_Data->lightDataBuffer.size() * sizeof(LightData));
+		SubmitTopDownSprites();
+
+		SceneFrame frame;
+		frame.batches = std::move(s_Data->batches);
+		frame.meshes = std::move(s_Data->meshes);
+		frame.retainedSprites = std::move(s_Data->retainedSprites);
+		frame.lights = std::move(s_Data->lightDataBuffer);
+		frame.cameraPosition = s_Data->cameraPosition;
+		frame.viewMatrix = s_Data->viewMatrix;
+		frame.projectionMatrix = s_Data->projectionMatrix;
+		frame.viewProjectionMatrix = s_Data->viewProjectionMatrix;
+		frame.topDownSorting = s_Data->topDownScene;
+		frame.gpuCulling = s_Data->gpuCulling;
+		frame.depthPrePass = s_Data->depthPrePass;
+		frame.culledCount = s_Data->culledCount;
+		s_Data->batches.clear();
+		s_Data->openBatches.clear();
+		s_Data->meshes.clear();
+		s_Data->retainedSprites = RetainedSpriteFrame();
+		s_Data->lightDataBuffer.clear();
 
-		std::ranges::sort(s_Data->batches, [](const Batch& a, const Batch& b)
+		RenderThread::submit([frame = std::move(frame)]() mutable
 		{
-			return static_cast<float>(a.specification.layer) + static_cast<float>(a.specification.alpha) / 2.0f < static_cast<float>(b.specification.layer) + static_cast<float>(b.specification.alpha) / 2.0f;
+			RenderScene(frame);
 		});
-		s_Data->lightStorageBuffer->bind(0);
-		std::string lastLayer;
-		for (auto& batch : s_Data->batches)
+	}
+
+	void Renderer2D::drawRetainedSprites(RetainedSprites& sprites)
+	{
+		// The buffer holds the content of whichever scene drew last, a new owner is uploaded whole
+		if (s_Data->retainedSpritesOwner != sprites.getId())
 		{
-			if (lastLayer != std::to_string(batch.specification.layer))
-			{
-				RenderAPI::get().clearDepthBuffer();
-			}
-			batch.render(batch.specification.alpha);
-			s_Stats->drawCalls++;
-			lastLayer = std::to_string(batch.specification.layer);
+			sprites.invalidate();
+			s_Data->retainedSpritesOwner = sprites.getId();
 		}
+		s_Data->culledCount += static_cast<int>(sprites.record(s_Data->retainedSprites, Frustum(s_Data->viewProjectionMatrix)));
+	}
+
+	void Renderer2D::setRetainedSprites(bool state)
+	{
+		s_Data->retainSprites = state;
+	}
+
+	bool Renderer2D::isRetainedSprites()
+	{
+		return s_Data->retainSprites;
+	}
+
+	void Renderer2D::setInstancedSprites(bool state)
+	{
+		s_Data->instancedSprites = state;
+	}
+
+	bool Renderer2D::isInstancedSprites()
+	{
+		return s_Data->instancedSprites;
+	}
+
+	void Renderer2D::setTopDownSorting(bool state)
+	{
+		s_Data->topDownSorting = state;
+	}
+
+	bool Renderer2D::isTopDownSorting()
+	{
+		return s_Data->topDownSorting;
+	}
+
+	void Renderer2D::setGpuCulling(bool state)
+	{
+		s_Data->gpuCulling = state;
+	}
+
+	bool Renderer2D::isGpuCulling()
+	{
+		return s_Data->gpuCulling;
 	}
 
 	Renderer2D::Stats& Renderer2D::getStats()
@@ -151,55 +712,19 @@ namespace Cardia
 		drawRect(transform, nullptr, color);
 	}
 
-	void Renderer2D::drawRect(const glm::mat4 &transform, const Texture2D *texture, const glm::vec4 &color, float tilingFactor, int32_t zIndex, float entityID)
+	void Renderer2D::drawRect(const glm::mat4 &transform, const Texture2D *texture, const glm::vec4 &color, float tilingFactor, int32_t zIndex, int32_t entityID, const glm::vec4& uvRect)
 	{
-		constexpr glm::vec2 texCoords[] {
-			{ 0.0f, 0.0f },
-			{ 1.0f, 0.0f },
-			{ 1.0f, 1.0f },
-			{ 0.0f, 1.0f }
-		};
-
-		constexpr glm::vec4 rectPositions[]
-		{
-			{ -0.5f, -0.5f, 0.0f, 1.0f },
-			{  0.5f, -0.5f, 0.0f, 1.0f },
-			{  0.5f,  0.5f, 0.0f, 1.0f },
-			{ -0.5f,  0.5f, 0.0f, 1.0f },
-		};
-		constexpr glm::vec4 normal { 0.0f, 0.0f, 1.0f, 0.0f };
-
-		SubMesh mesh;
-		const auto finalNormal = glm::mat3(glm::transpose(glm::inverse(transform))) * normal;
-		for (int i = 0; i < sizeof(rectPositions) / sizeof(glm::vec4); ++i)
+		if (s_Data->topDownScene)
 		{
-			auto vertex = Vertex();
-			vertex.position = transform * rectPositions[i];
-			vertex.normal = finalNormal;
-			vertex.color = color;
-			vertex.textureCoord = texCoords[i % 4];
-			vertex.tilingFactor = tilingFactor;
-			vertex.entityID = entityID;
-			mesh.GetVertices().push_back(vertex);
+			s_Data->topDownSprites.push_back({ transform, texture, color, uvRect, tilingFactor, zIndex, entityID });
+			return;
 		}
+		SubmitRect(transform, texture, color, tilingFactor, zIndex, entityID, uvRect);
+	}
 
-		mesh.GetIndices() = std::vector<uint32_t>({ 0, 1, 2, 2, 3, 0 });
-		s_Stats->triangleCount += 2;
-
-		BatchSpecification specification;
-		specification.alpha = color.a < 1.0f;
-		specification.layer = zIndex;
-		specification.shader = "basic";
-		if (texture)
-			specification.texture = texture->getPath();
-
-		for (auto& batch : s_Data->batches)
-		{
-			if (batch.specification == specification && batch.addMesh(&mesh))
-				return;
-		}
-		auto& batch = s_Data->batches.emplace_back(s_Data->vertexArray.get(), s_Data->cameraPosition, texture, specification);
-		batch.addMesh(&mesh);
+	void Renderer2D::drawMesh(std::shared_ptr<MeshRenderer> meshRenderer, const glm::mat4& transform, int32_t entityID)
+	{
+		s_Data->meshes.push_back({ std::move(meshRenderer), transform, entityID });
 	}
 
 	void Renderer2D::addLight(const Component::Transform& transform, const Component::Light& lightComponent)
@@ -212,4 +737,9 @@ namespace Cardia
 		light.directionAndRange = glm::vec4(forward, lightComponent.range);
 		light.colorAndCutOff = glm::vec4(lightComponent.color, 1.0f - std::fmod(lightComponent.angle, 360.0f) / 360);
 	}
+
+	void Renderer2D::addCulledObjects(int count)
+	{
+		s_Data->culledCount += count;
+	}
 }
@@ -0,0 +1,242 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/RetainedSprites.hpp"
+
+
+namespace Cardia
+{
+	constexpr uint32_t minGroupCapacity = 64;
+
+	// Unit quad of drawRect, the transform gives its world extents
+	static const AABB quadBounds { { -0.5f, -0.5f, 0.0f }, { 0.5f, 0.5f, 0.0f } };
+
+	static glm::ivec2 CellOf(const AABB& bounds)
+	{
+		const glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+		return glm::ivec2(glm::floor(glm::vec2(center) / retainedSpriteCellSize));
+	}
+
+	static RetainedSprites::GroupKey MakeGroupKey(const BatchSpecification& specification, const Texture2D* texture, const glm::ivec2& cell)
+	{
+		return { specification.key(), texture, cell.x, cell.y };
+	}
+
+	static uint32_t s_NextId = 0;
+
+	RetainedSprites::RetainedSprites()
+		: m_Id(s_NextId++)
+	{
+	}
+
+	RetainedSprites::Handle RetainedSprites::add(const glm::mat4& transform, const std::shared_ptr<Texture2D>& texture, const glm::vec4& color, const glm::vec4& uvRect, float tilingFactor, int32_t zIndex, int32_t entityID)
+	{
+		Handle handle;
+		if (m_FreeHandles.empty())
+		{
+			handle = static_cast<Handle>(m_Locations.size());
+			m_Locations.emplace_back();
+		}
+		else
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+
+		const auto specification = MakeSpriteSpecification(texture.get(), color, zIndex, true);
+		const auto bounds = quadBounds.Transform(transform);
+		if (!insert(handle, findGroup(specification, texture, CellOf(bounds)), MakeSpriteInstance(transform, color, uvRect, tilingFactor, entityID), bounds))
+		{
+			m_FreeHandles.push_back(handle);
+			return invalidHandle;
+		}
+		return handle;
+	}
+
+	bool RetainedSprites::update(Handle handle, const glm::mat4& transform, const std::shared_ptr<Texture2D>& texture, const glm::vec4& color, const glm::vec4& uvRect, float tilingFactor, int32_t zIndex, int32_t entityID)
+	{
+		const auto sprite = MakeSpriteInstance(transform, color, uvRect, tilingFactor, entityID);
+		const auto specification = MakeSpriteSpecification(texture.get(), color, zIndex, true);
+		const auto bounds = quadBounds.Transform(transform);
+		const auto cell = CellOf(bounds);
+
+		const auto location = m_Locations[handle];
+		auto& group = m_Groups[location.group];
+		if (group.specification == specification && group.texture == texture && group.cell == cell)
+		{
+			group.bounds.Expand(bounds);
+			auto& instance = group.instances[location.index];
+			const auto textureIndex = instance.textureIndex;
+			instance = sprite;
+			instance.textureIndex = textureIndex;
+			m_Dirty.push_back(location);
+			return true;
+		}
+
+		erase(handle);
+		if (!insert(handle, findGroup(specification, texture, cell), sprite, bounds))
+		{
+			m_FreeHandles.push_back(handle);
+			return false;
+		}
+		return true;
+	}
+
+	void RetainedSprites::remove(Handle handle)
+	{
+		erase(handle);
+		m_FreeHandles.push_back(handle);
+	}
+
+	void RetainedSprites::invalidate()
+	{
+		for (auto& group : m_Groups)
+			group.relocated = true;
+	}
+
+	uint32_t RetainedSprites::record(RetainedSpriteFrame& frame, const Frustum& frustum)
+	{
+		uint32_t culledCount = 0;
+		frame.uploads.clear();
+		frame.uploadData.clear();
+		frame.draws.clear();
+		frame.releasedTextures = std::move(m_ReleasedTextures);
+		m_ReleasedTextures.clear();
+
+		// Changed instances sorted by buffer position, neighbours are sent in a single upload
+		std::vector<std::pair<uint32_t, const SpriteInstance*>> changes;
+		for (const auto& [groupIndex, index] : m_Dirty)
+		{
+			const auto& group = m_Groups[groupIndex];
+			if (group.relocated || index >= group.instances.size())
+				continue;
+			changes.emplace_back(group.firstInstance + index, &group.instances[index]);
+		}
+		m_Dirty.clear();
+
+		for (auto& group : m_Groups)
+		{
+			if (group.instances.empty())
+				continue;
+
+			if (group.relocated)
+			{
+				for (uint32_t index = 0; index < group.instances.size(); ++index)
+					changes.emplace_back(group.firstInstance + index, &group.instances[index]);
+				group.relocated = false;
+			}
+
+			// Still uploaded above, the buffer has to be up to date once the group comes back into view
+			if (!frustum.Intersects(group.bounds))
+			{
+				culledCount += static_cast<uint32_t>(group.instances.size());
+				continue;
+			}
+			frame.draws.push_back({ group.specification, group.texture, group.firstInstance, static_cast<uint32_t>(group.instances.size()) });
+		}
+
+		std::ranges::sort(changes, {}, &std::pair<uint32_t, const SpriteInstance*>::first);
+		const auto duplicates = std::ranges::unique(changes, {}, &std::pair<uint32_t, const SpriteInstance*>::first);
+		changes.erase(duplicates.begin(), duplicates.end());
+
+		for (const auto& [position, instance] : changes)
+		{
+			if (frame.uploads.empty() || frame.uploads.back().firstInstance + frame.uploads.back().instanceCount != position)
+				frame.uploads.push_back({ position, 0 });
+			frame.uploads.back().instanceCount++;
+			frame.uploadData.push_back(*instance);
+		}
+		return culledCount;
+	}
+
+	uint32_t RetainedSprites::findGroup(const BatchSpecification& specification, const std::shared_ptr<Texture2D>& texture, const glm::ivec2& cell)
+	{
+		const auto key = MakeGroupKey(specification, texture.get(), cell);
+		const auto it = m_GroupLookup.find(key);
+		if (it != m_GroupLookup.end())
+			return it->second;
+
+		uint32_t index;
+		if (m_FreeGroups.empty())
+		{
+			index = static_cast<uint32_t>(m_Groups.size());
+			m_Groups.emplace_back();
+		}
+		else
+		{
+			index = m_FreeGroups.back();
+			m_FreeGroups.pop_back();
+		}
+
+		auto& group = m_Groups[index];
+		group.specification = specification;
+		group.texture = texture;
+		group.cell = cell;
+		m_GroupLookup.emplace(key, index);
+		return index;
+	}
+
+	bool RetainedSprites::insert(Handle handle, uint32_t groupIndex, SpriteInstance sprite, const AABB& bounds)
+	{
+		auto& group = m_Groups[groupIndex];
+		if (group.instances.size() == group.capacity)
+		{
+			// Moved to a range twice as big, the old one is reused by later allocations
+			const uint32_t capacity = std::max(minGroupCapacity, group.capacity * 2);
+			const uint32_t firstInstance = m_Allocator.Allocate(capacity);
+			if (firstInstance == RangeAllocator::invalidOffset)
+			{
+				if (group.instances.empty())
+					releaseGroup(groupIndex);
+				return false;
+			}
+
+			if (group.capacity)
+				m_Allocator.Free(group.firstInstance, group.capacity);
+			group.firstInstance = firstInstance;
+			group.capacity = capacity;
+			group.relocated = true;
+		}
+
+		// Slot 0 is the white texture, the group texture is bound to slot 1
+		sprite.textureIndex = group.texture ? 1 : 0;
+		m_Locations[handle] = { groupIndex, static_cast<uint32_t>(group.instances.size()) };
+		m_Dirty.push_back(m_Locations[handle]);
+		group.bounds.Expand(bounds);
+		group.instances.push_back(sprite);
+		group.handles.push_back(handle);
+		return true;
+	}
+
+	void RetainedSprites::erase(Handle handle)
+	{
+		const auto [groupIndex, index] = m_Locations[handle];
+		auto& group = m_Groups[groupIndex];
+
+		// The last sprite fills the hole, the group stays contiguous
+		const auto last = static_cast<uint32_t>(group.instances.size() - 1);
+		if (index != last)
+		{
+			group.instances[index] = group.instances[last];
+			group.handles[index] = group.handles[last];
+			m_Locations[group.handles[index]].index = index;
+			m_Dirty.push_back({ groupIndex, index });
+		}
+		group.instances.pop_back();
+		group.handles.pop_back();
+
+		if (group.instances.empty())
+			releaseGroup(groupIndex);
+	}
+
+	void RetainedSprites::releaseGroup(uint32_t groupIndex)
+	{
+		auto& group = m_Groups[groupIndex];
+		if (group.capacity)
+			m_Allocator.Free(group.firstInstance, group.capacity);
+		m_GroupLookup.erase(MakeGroupKey(group.specification, group.texture.get(), group.cell));
+		// The frame being recorded may still be the last owner, the texture is released on the back end
+		if (group.texture)
+			m_ReleasedTextures.push_back(std::move(group.texture));
+		group = Group();
+		m_FreeGroups.push_back(groupIndex);
+	}
+}
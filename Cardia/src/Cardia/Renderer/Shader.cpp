@@ -1,27 +1,56 @@
 #include "cdpch.hpp"
 #include "Cardia/Renderer/Shader.hpp"
 #include "Cardia/Core/Log.hpp"
+#include "Cardia/Renderer/Batch.hpp"
 #include "Cardia/Renderer/Renderer.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLShader.hpp"
+#include "Cardia/Renderer/Null/NullShader.hpp"
 
 
 namespace Cardia
 {
-	std::unique_ptr<Shader> Shader::create(std::initializer_list<std::string> filePaths)
+	std::string ShaderFeatureDefines(ShaderFeatures features)
+	{
+		constexpr const char* defines[] { "CD_TEXTURED", "CD_LIT", "CD_ALPHA_TEST", "CD_INSTANCED" };
+
+		std::string result;
+		for (size_t bit = 0; bit < std::size(defines); ++bit)
+		{
+			if (features & (1u << bit))
+				result += std::string("#define ") + defines[bit] + '\n';
+		}
+		// Sizes u_Textures, a sampler array larger than the driver's units fails to link
+		const int textureSlots = std::min(maxTextureSlots, RenderAPI::get().getMaxTextureSlots());
+		result += "#define CD_MAX_TEXTURE_SLOTS " + std::to_string(textureSlots) + '\n';
+		return result;
+	}
+
+	std::unique_ptr<Shader> Shader::create(const std::vector<std::string>& filePaths, ShaderFeatures features)
 	{
 		RenderAPI::API& renderer = Renderer::getAPI();
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
-				Log::coreError("{0} is not supported for the moment !", renderer);
-				cdCoreAssert(false, "Invalid API provided");
-				return nullptr;
+				return std::make_unique<NullShader>();
 			case RenderAPI::API::OpenGL:
-				return std::make_unique<OpenGLShader>(filePaths);
+				return std::make_unique<OpenGLShader>(filePaths, features);
 			default:
 				Log::coreError("{0} is not supported for the moment !", renderer);
 				cdCoreAssert(false, "Invalid API provided");
 				return nullptr;
 		}
 	}
-}
+
+	ShaderVariants::ShaderVariants(std::vector<std::string> filePaths)
+		: m_FilePaths(std::move(filePaths))
+	{
+	}
+
+	Shader& ShaderVariants::get(ShaderFeatures features)
+	{
+		auto& variant = m_Variants[features];
+		if (!variant)
+			variant = Shader::create(m_FilePaths, features);
+		return *variant;
+	}
+}
\ No newline at end of file
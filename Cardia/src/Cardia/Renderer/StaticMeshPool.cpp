@@ -0,0 +1,399 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/StaticMeshPool.hpp"
+
+#include <array>
+#include <mutex>
+
+#include "Cardia/Renderer/Batch.hpp"
+#include "Cardia/Renderer/RenderAPI.hpp"
+#include "Cardia/Renderer/Renderer2D.hpp"
+#include "Cardia/DataStructure/RangeAllocator.hpp"
+#include "Cardia/DataStructure/RadixSort.hpp"
+
+
+namespace Cardia
+{
+	constexpr uint32_t arenaVertexCount = 1 << 18;
+	constexpr uint32_t arenaIndexCount = 1 << 20;
+	constexpr int drawDataBinding = 1;
+	constexpr int cullDataBinding = 2;
+	constexpr int commandBinding = 3;
+	constexpr int visibleCommandBinding = 4;
+	constexpr int drawCountBinding = 5;
+	constexpr uint32_t cullGroupSize = 64; // local_size_x of mesh_cull.comp
+
+	// std430 layout of the per-draw storage buffer read by mesh.vert
+	struct MeshDrawData
+	{
+		glm::mat4 model;
+		glm::mat3x4 normalMatrix; // mat3 columns are padded to vec4
+		int32_t textureIndex;
+		int32_t entityID;
+		int32_t padding[2];
+	};
+	static_assert(sizeof(MeshDrawData) == 128, "MeshDrawData must match its std430 layout");
+
+	// std430 layout of the cull input read by mesh_cull.comp
+	struct MeshCullData
+	{
+		glm::vec4 boundsMin;
+		glm::vec4 boundsMax;
+		uint32_t group;
+		uint32_t groupFirstCommand;
+		uint32_t padding[2];
+	};
+	static_assert(sizeof(MeshCullData) == 48, "MeshCullData must match its std430 layout");
+
+	struct GeometryArena
+	{
+		VertexFormat format;
+		std::unique_ptr<VertexArray> vertexArray;
+		RangeAllocator vertices;
+		RangeAllocator indices;
+	};
+
+	struct MeshDraw
+	{
+		MeshAllocation allocation;
+		AABB bounds;
+		glm::mat4 model;
+		const Texture2D* texture;
+		int32_t entityID;
+	};
+
+	struct DrawGroup
+	{
+		uint32_t arena;
+		uint32_t firstCommand;
+		uint32_t commandCount;
+		uint32_t triangleCount;
+		std::array<const Texture2D*, maxTextureSlots> textures;
+		int32_t textureCount;
+	};
+
+	struct StaticMeshPoolData
+	{
+		// Arenas are only appended, a null entry is a released dedicated arena
+		std::mutex arenaMutex;
+		std::vector<std::unique_ptr<GeometryArena>> arenas;
+
+		std::vector<MeshDraw> draws;
+		std::vector<SortItem> drawOrder;
+		std::vector<SortItem> drawOrderScratch;
+		std::vector<MeshDrawData> drawData;
+		std::vector<DrawElementsIndirectCommand> commands;
+		std::vector<MeshCullData> cullData;
+		std::vector<uint32_t> drawCounts;
+		std::vector<DrawGroup> groups;
+
+		std::unique_ptr<StorageBuffer> drawDataBuffer;
+		uint32_t drawDataCapacity {};
+		std::unique_ptr<IndirectBuffer> commandBuffer;
+
+		// GPU culling, sized along with the draw data
+		std::unique_ptr<Shader> cullShader;
+		std::unique_ptr<StorageBuffer> cullDataBuffer;
+		std::unique_ptr<IndirectBuffer> visibleCommandBuffer;
+		std::unique_ptr<IndirectBuffer> drawCountBuffer;
+		uint32_t drawCountCapacity {};
+
+		std::unique_ptr<Texture2D> whiteTexture;
+	};
+
+	static std::unique_ptr<StaticMeshPoolData> s_Data {};
+
+	static uint32_t CreateArena(VertexFormat format, uint32_t vertexCount, uint32_t indexCount)
+	{
+		auto arena = std::make_unique<GeometryArena>();
+		arena->format = format;
+		arena->vertices = RangeAllocator(vertexCount);
+		arena->indices = RangeAllocator(indexCount);
+		arena->vertexArray = VertexArray::create();
+
+		const uint32_t vertexSize = format == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+		std::unique_ptr<VertexBuffer> vbo = VertexBuffer::create(vertexCount * vertexSize);
+		vbo->setLayout(GetVertexLayout(format));
+		arena->vertexArray->setVertexBuffer(std::move(vbo));
+		arena->vertexArray->setIndexBuffer(IndexBuffer::create(indexCount));
+
+		s_Data->arenas.push_back(std::move(arena));
+		return static_cast<uint32_t>(s_Data->arenas.size() - 1);
+	}
+
+	void StaticMeshPool::init()
+	{
+		s_Data = std::make_unique<StaticMeshPoolData>();
+
+		uint32_t whiteColor = 0xffffffff;
+		s_Data->whiteTexture = Texture2D::create(1, 1, &whiteColor);
+
+		s_Data->cullShader = Shader::create({"resources/shaders/mesh_cull.comp"});
+	}
+
+	void StaticMeshPool::quit()
+	{
+		s_Data.reset();
+	}
+
+	MeshAllocation StaticMeshPool::allocate(const SubMesh& subMesh, VertexFormat format)
+	{
+		const auto& vertices = subMesh.GetVertices();
+		const auto& indices = subMesh.GetIndices();
+		const auto vertexCount = static_cast<uint32_t>(vertices.size());
+		const auto indexCount = static_cast<uint32_t>(indices.size());
+		if (vertexCount == 0 || indexCount == 0)
+			return {};
+
+		std::lock_guard lock(s_Data->arenaMutex);
+
+		MeshAllocation allocation;
+		for (uint32_t index = 0; index < s_Data->arenas.size(); ++index)
+		{
+			auto& arena = s_Data->arenas[index];
+			if (!arena || arena->format != format)
+				continue;
+			if (arena->vertices.GetFreeSize() < vertexCount || arena->indices.GetFreeSize() < indexCount)
+				continue;
+
+			const uint32_t firstVertex = arena->vertices.Allocate(vertexCount);
+			if (firstVertex == RangeAllocator::invalidOffset)
+				continue;
+			const uint32_t firstIndex = arena->indices.Allocate(indexCount);
+			if (firstIndex == RangeAllocator::invalidOffset)
+			{
+				arena->vertices.Free(firstVertex, vertexCount);
+				continue;
+			}
+			allocation = { index, firstVertex, vertexCount, firstIndex, indexCount };
+			break;
+		}
+
+		if (!allocation.isValid())
+		{
+			// Meshes bigger than a regular arena get one of their own
+			const uint32_t arena = CreateArena(format, std::max(vertexCount, arenaVertexCount), std::max(indexCount, arenaIndexCount));
+			allocation = { arena, s_Data->arenas[arena]->vertices.Allocate(vertexCount), vertexCount, s_Data->arenas[arena]->indices.Allocate(indexCount), indexCount };
+		}
+
+		auto& vertexArray = *s_Data->arenas[allocation.arena]->vertexArray;
+		if (format == VertexFormat::Packed)
+		{
+			std::vector<PackedVertex> packedVertices;
+			packedVertices.reserve(vertices.size());
+			std::ranges::transform(vertices, std::back_inserter(packedVertices), PackVertex);
+			vertexArray.getVertexBuffer().setData(packedVertices.data(), vertexCount * sizeof(PackedVertex), allocation.firstVertex * sizeof(PackedVertex));
+		}
+		else
+		{
+			vertexArray.getVertexBuffer().setData(vertices.data(), vertexCount * sizeof(Vertex), allocation.firstVertex * sizeof(Vertex));
+		}
+		vertexArray.getIndexBuffer().setData(indices.data(), indexCount * sizeof(uint32_t), allocation.firstIndex * sizeof(uint32_t));
+
+		return allocation;
+	}
+
+	void StaticMeshPool::free(const MeshAllocation& allocation)
+	{
+		if (!s_Data || !allocation.isValid())
+			return;
+
+		std::lock_guard lock(s_Data->arenaMutex);
+		auto& arena = s_Data->arenas[allocation.arena];
+		arena->vertices.Free(allocation.firstVertex, allocation.vertexCount);
+		arena->indices.Free(allocation.firstIndex, allocation.indexCount);
+
+		const bool dedicated = arena->vertices.GetCapacity() > arenaVertexCount || arena->indices.GetCapacity() > arenaIndexCount;
+		if (dedicated && arena->vertices.GetFreeSize() == arena->vertices.GetCapacity())
+			arena.reset();
+	}
+
+	void StaticMeshPool::submit(const MeshAllocation& allocation, const AABB& bounds, const glm::mat4& model, const Texture2D* texture, int32_t entityID)
+	{
+		if (!allocation.isValid())
+			return;
+		s_Data->draws.push_back({ allocation, bounds, model, texture, entityID });
+	}
+
+	// Compacts the visible commands of every group, drawCounts receives how many survived per group
+	static void CullDraws(const Frustum& frustum, uint32_t drawCount)
+	{
+		const auto groupCount = static_cast<uint32_t>(s_Data->groups.size());
+		if (groupCount > s_Data->drawCountCapacity)
+		{
+			s_Data->drawCountCapacity = std::max(groupCount, s_Data->drawCountCapacity * 2);
+			s_Data->drawCountBuffer = IndirectBuffer::create(s_Data->drawCountCapacity * sizeof(uint32_t));
+		}
+		s_Data->drawCounts.assign(groupCount, 0);
+		s_Data->drawCountBuffer->setData(s_Data->drawCounts.data(), groupCount * sizeof(uint32_t));
+		s_Data->cullDataBuffer->setData(s_Data->cullData.data(), drawCount * sizeof(MeshCullData));
+
+		s_Data->drawDataBuffer->bind(drawDataBinding);
+		s_Data->cullDataBuffer->bind(cullDataBinding);
+		s_Data->commandBuffer->bindStorage(commandBinding);
+		s_Data->visibleCommandBuffer->bindStorage(visibleCommandBinding);
+		s_Data->drawCountBuffer->bindStorage(drawCountBinding);
+
+		auto& cullShader = *s_Data->cullShader;
+		cullShader.bind();
+		const auto& planes = frustum.GetPlanes();
+		cullShader.setFloat4Array("u_FrustumPlanes", planes.data(), static_cast<int>(planes.size()));
+		cullShader.setInt("u_DrawCount", static_cast<int>(drawCount));
+
+		RenderAPI::get().dispatchCompute((drawCount + cullGroupSize - 1) / cullGroupSize);
+		RenderAPI::get().computeBarrier();
+	}
+
+	// One multi-draw per group, the caller holds the arena mutex
+	static void DrawGroups(Shader& shader, bool gpuCulling)
+	{
+		shader.bind();
+
+		// With GPU culling the triangle count is an upper bound, the surviving count never reaches the CPU
+		auto& stats = Renderer2D::getStats();
+		for (uint32_t groupIndex = 0; groupIndex < s_Data->groups.size(); ++groupIndex)
+		{
+			const auto& drawGroup = s_Data->groups[groupIndex];
+			for (int32_t slot = 0; slot < drawGroup.textureCount; ++slot)
+				drawGroup.textures[slot]->bind(slot);
+
+			const auto* vertexArray = s_Data->arenas[drawGroup.arena]->vertexArray.get();
+			vertexArray->bind();
+			if (gpuCulling)
+				RenderAPI::get().multiDrawIndexedIndirectCount(vertexArray, *s_Data->visibleCommandBuffer, *s_Data->drawCountBuffer, groupIndex, drawGroup.commandCount, drawGroup.firstCommand);
+			else
+				RenderAPI::get().multiDrawIndexedIndirect(vertexArray, *s_Data->commandBuffer, drawGroup.commandCount, drawGroup.firstCommand);
+			stats.drawCalls++;
+			stats.triangleCount += static_cast<int>(drawGroup.triangleCount);
+		}
+	}
+
+	void StaticMeshPool::flush(Shader& shader, const Frustum* gpuCulling, const MeshDepthPrePass* depthPrePass)
+	{
+		if (s_Data->draws.empty())
+			return;
+
+		// Nothing is drawn until the variant is compiled, meshes are submitted again every frame
+		if (!shader.isReady())
+		{
+			s_Data->draws.clear();
+			return;
+		}
+		if (gpuCulling && !s_Data->cullShader->isReady())
+			gpuCulling = nullptr;
+
+		// Arena first so each one is bound once, the sort is stable and keeps submission order inside an arena.
+		// Under a depth pre-pass, draws of an arena go nearest first.
+		s_Data->drawOrder.clear();
+		for (uint32_t index = 0; index < s_Data->draws.size(); ++index)
+		{
+			const auto& draw = s_Data->draws[index];
+			uint64_t key = static_cast<uint64_t>(draw.allocation.arena) << 32;
+			if (depthPrePass)
+			{
+				const glm::vec3 center = draw.model * glm::vec4((draw.bounds.min + draw.bounds.max) * 0.5f, 1.0f);
+				const glm::vec3 toCamera = center - depthPrePass->viewPosition;
+				key |= FloatSortKey(glm::dot(toCamera, toCamera));
+			}
+			s_Data->drawOrder.push_back({ key, index });
+		}
+		RadixSort(s_Data->drawOrder, s_Data->drawOrderScratch);
+
+		const int32_t maxSlots = std::min(maxTextureSlots, RenderAPI::get().getMaxTextureSlots());
+		s_Data->drawData.clear();
+		s_Data->commands.clear();
+		s_Data->cullData.clear();
+		s_Data->groups.clear();
+
+		DrawGroup* group = nullptr;
+		for (const auto& item : s_Data->drawOrder)
+		{
+			const auto& draw = s_Data->draws[item.index];
+			const Texture2D* texture = draw.texture ? draw.texture : s_Data->whiteTexture.get();
+
+			int32_t textureIndex = -1;
+			if (group && group->arena == draw.allocation.arena)
+			{
+				for (int32_t slot = 0; slot < group->textureCount; ++slot)
+				{
+					if (group->textures[slot] == texture)
+					{
+						textureIndex = slot;
+						break;
+					}
+				}
+			}
+
+			const bool groupFull = group && textureIndex < 0 && group->textureCount >= maxSlots;
+			if (!group || group->arena != draw.allocation.arena || groupFull)
+			{
+				group = &s_Data->groups.emplace_back();
+				group->arena = draw.allocation.arena;
+				group->firstCommand = static_cast<uint32_t>(s_Data->commands.size());
+				group->commandCount = 0;
+				group->triangleCount = 0;
+				group->textures[0] = s_Data->whiteTexture.get();
+				group->textureCount = 1;
+				textureIndex = texture == s_Data->whiteTexture.get() ? 0 : -1;
+			}
+
+			if (textureIndex < 0)
+			{
+				textureIndex = group->textureCount++;
+				group->textures[textureIndex] = texture;
+			}
+
+			const auto drawIndex = static_cast<uint32_t>(s_Data->drawData.size());
+			const glm::mat3x4 normalMatrix(glm::mat3(glm::transpose(glm::inverse(draw.model))));
+			s_Data->drawData.push_back({ draw.model, normalMatrix, textureIndex, draw.entityID, {} });
+			s_Data->commands.push_back({
+				draw.allocation.indexCount,
+				1,
+				draw.allocation.firstIndex,
+				static_cast<int32_t>(draw.allocation.firstVertex),
+				drawIndex
+			});
+			if (gpuCulling)
+			{
+				const auto groupIndex = static_cast<uint32_t>(s_Data->groups.size() - 1);
+				s_Data->cullData.push_back({ glm::vec4(draw.bounds.min, 0.0f), glm::vec4(draw.bounds.max, 0.0f), groupIndex, group->firstCommand, {} });
+			}
+			group->commandCount++;
+			group->triangleCount += draw.allocation.indexCount / 3;
+		}
+
+		const auto drawCount = static_cast<uint32_t>(s_Data->drawData.size());
+		if (drawCount > s_Data->drawDataCapacity)
+		{
+			s_Data->drawDataCapacity = std::max(drawCount, s_Data->drawDataCapacity * 2);
+			s_Data->drawDataBuffer = StorageBuffer::create(s_Data->drawDataCapacity * sizeof(MeshDrawData));
+			s_Data->commandBuffer = IndirectBuffer::create(s_Data->drawDataCapacity * sizeof(DrawElementsIndirectCommand));
+			s_Data->cullDataBuffer = StorageBuffer::create(s_Data->drawDataCapacity * sizeof(MeshCullData));
+			s_Data->visibleCommandBuffer = IndirectBuffer::create(s_Data->drawDataCapacity * sizeof(DrawElementsIndirectCommand));
+		}
+		s_Data->drawDataBuffer->setData(s_Data->drawData.data(), drawCount * sizeof(MeshDrawData));
+		s_Data->commandBuffer->setData(s_Data->commands.data(), drawCount * sizeof(DrawElementsIndirectCommand));
+		if (gpuCulling)
+			CullDraws(*gpuCulling, drawCount);
+		s_Data->drawDataBuffer->bind(drawDataBinding);
+
+		std::lock_guard lock(s_Data->arenaMutex);
+		if (depthPrePass)
+		{
+			RenderAPI::get().setColorWrite(false);
+			DrawGroups(*depthPrePass->shader, gpuCulling);
+			RenderAPI::get().setColorWrite(true);
+			RenderAPI::get().setDepthWrite(false);
+			RenderAPI::get().setDepthFunction(RenderAPI::DepthFunction::Equal);
+		}
+
+		DrawGroups(shader, gpuCulling);
+
+		if (depthPrePass)
+		{
+			RenderAPI::get().setDepthWrite(true);
+			RenderAPI::get().setDepthFunction(RenderAPI::DepthFunction::Less);
+		}
+
+		s_Data->draws.clear();
+	}
+}
@@ -1,42 +1,39 @@
-#include <Cardia/Renderer/RenderAPI.hpp>
-#include <Cardia/Renderer/Renderer2D.hpp>
 #include "cdpch.hpp"
 
 #include "Cardia/Renderer/SubMeshRenderer.hpp"
 
 namespace Cardia
 {
-
-	void SubMeshRenderer::SubmitSubMesh(SubMesh &subMesh)
+	SubMeshRenderer::~SubMeshRenderer()
 	{
-		m_VertexArray = VertexArray::create();
-
-		auto& vertices = subMesh.GetVertices();
-		std::unique_ptr<VertexBuffer> vbo = VertexBuffer::create(vertices.data(), vertices.size() * sizeof(Vertex));
-
-		vbo->setLayout({
-			   {ShaderDataType::Float3, "a_Position"},
-			   {ShaderDataType::Float3, "a_Normal"},
-			   {ShaderDataType::Float4, "a_Color"},
-			   {ShaderDataType::Float2, "a_TexPos"},
-			   {ShaderDataType::Float, "a_TilingFactor"},
-			   {ShaderDataType::Float, "a_EntityID"}
-		});
+		StaticMeshPool::free(m_Allocation);
+	}
 
-		m_VertexArray->setVertexBuffer(std::move(vbo));
+	SubMeshRenderer::SubMeshRenderer(SubMeshRenderer&& other) noexcept
+		: m_Allocation(std::exchange(other.m_Allocation, {})), m_Bounds(other.m_Bounds)
+	{
+	}
 
-		auto& indices = subMesh.GetIndices();
-		std::unique_ptr<IndexBuffer> ibo = IndexBuffer::create(indices.data(), indices.size());
-		m_VertexArray->setIndexBuffer(std::move(ibo));
+	SubMeshRenderer& SubMeshRenderer::operator=(SubMeshRenderer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			StaticMeshPool::free(m_Allocation);
+			m_Allocation = std::exchange(other.m_Allocation, {});
+			m_Bounds = other.m_Bounds;
+		}
+		return *this;
 	}
 
-	void SubMeshRenderer::Draw()
+	void SubMeshRenderer::SubmitSubMesh(SubMesh &subMesh, VertexFormat format)
 	{
-		m_VertexArray->bind();
-		m_VertexArray->getIndexBuffer().bind();
-		Renderer2D::getStats().drawCalls++;
-		Renderer2D::getStats().triangleCount += m_VertexArray->getIndexBuffer().getCount() / 3;
+		StaticMeshPool::free(m_Allocation);
+		m_Allocation = StaticMeshPool::allocate(subMesh, format);
+		m_Bounds = subMesh.GetBounds();
+	}
 
-		RenderAPI::get().drawIndexed(m_VertexArray.get(), m_VertexArray->getIndexBuffer().getCount());
+	void SubMeshRenderer::Submit(const glm::mat4& model, const Texture2D* texture, int32_t entityID) const
+	{
+		StaticMeshPool::submit(m_Allocation, m_Bounds, model, texture, entityID);
 	}
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 #include "Cardia/Renderer/Texture.hpp"
 #include "Cardia/Renderer/Renderer.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLTexture.hpp"
+#include "Cardia/Renderer/Null/NullTexture.hpp"
 
 
 namespace Cardia
@@ -13,9 +14,7 @@ namespace Cardia
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
-				Log::coreError("{0} is not supported for the moment !", renderer);
-				cdCoreAssert(false, "Invalid API provided");
-				return nullptr;
+				return std::make_unique<NullTexture2D>(path);
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLTexture2D>(path);
 			default:
@@ -31,9 +30,7 @@ namespace Cardia
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
-				Log::coreError("{0} is not supported for the moment !", renderer);
-				cdCoreAssert(false, "Invalid API provided");
-				return nullptr;
+				return std::make_unique<NullTexture2D>(width, height, data);
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLTexture2D>(width, height, data);
 			default:
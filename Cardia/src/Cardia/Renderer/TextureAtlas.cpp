@@ -0,0 +1,184 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/TextureAtlas.hpp"
+#include "Cardia/Renderer/TextureData.hpp"
+#include "Cardia/DataStructure/RectanglePacker.hpp"
+#include "Cardia/Core/Log.hpp"
+
+#include <json/json.h>
+#include <stb_image/stb_image.h>
+
+
+namespace Cardia
+{
+	// Edge texels repeated around every sprite, neighbours do not bleed in through filtering and the first mips
+	constexpr int atlasPadding = 2;
+	constexpr int minAtlasSize = 256;
+	constexpr int maxAtlasSize = 4096;
+
+	namespace
+	{
+		struct SpriteImage
+		{
+			std::string name;
+			int width;
+			int height;
+			std::vector<uint8_t> pixels; // RGBA, bottom-up
+			glm::ivec2 position {};
+		};
+
+		bool IsImage(const std::filesystem::path& path)
+		{
+			auto extension = path.extension().string();
+			std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+		}
+
+		// Places every sprite or none, the padding is part of the placed rectangle
+		bool PackSprites(std::vector<SpriteImage>& sprites, int width, int height)
+		{
+			RectanglePacker packer(width, height);
+			for (auto& sprite : sprites)
+			{
+				if (!packer.Pack(sprite.width + 2 * atlasPadding, sprite.height + 2 * atlasPadding, sprite.position))
+					return false;
+				sprite.position += atlasPadding;
+			}
+			return true;
+		}
+
+		void CopySprite(const SpriteImage& sprite, std::vector<uint8_t>& atlas, int atlasWidth)
+		{
+			for (int y = -atlasPadding; y < sprite.height + atlasPadding; ++y)
+			{
+				const int sourceY = std::clamp(y, 0, sprite.height - 1);
+				for (int x = -atlasPadding; x < sprite.width + atlasPadding; ++x)
+				{
+					const int sourceX = std::clamp(x, 0, sprite.width - 1);
+					const size_t source = (static_cast<size_t>(sourceY) * sprite.width + sourceX) * 4;
+					const size_t destination = (static_cast<size_t>(sprite.position.y + y) * atlasWidth + sprite.position.x + x) * 4;
+					std::copy_n(sprite.pixels.data() + source, 4, atlas.data() + destination);
+				}
+			}
+		}
+	}
+
+	TextureAtlas::TextureAtlas(std::shared_ptr<Texture2D> texture, std::unordered_map<std::string, AtlasRegion> regions)
+		: m_Texture(std::move(texture)), m_Regions(std::move(regions))
+	{
+	}
+
+	const AtlasRegion* TextureAtlas::findRegion(const std::string& name) const
+	{
+		const auto region = m_Regions.find(name);
+		return region != m_Regions.end() ? &region->second : nullptr;
+	}
+
+	bool TextureAtlas::pack(const std::filesystem::path& folder, const std::filesystem::path& atlasPath)
+	{
+		std::vector<std::filesystem::path> files;
+		for (const auto& entry : std::filesystem::directory_iterator(folder))
+		{
+			if (entry.is_regular_file() && IsImage(entry.path()))
+				files.push_back(entry.path());
+		}
+		std::ranges::sort(files);
+
+		std::vector<SpriteImage> sprites;
+		stbi_set_flip_vertically_on_load(true);
+		for (const auto& file : files)
+		{
+			int width, height, nbChannels;
+			unsigned char* data = stbi_load(file.string().c_str(), &width, &height, &nbChannels, 4);
+			if (!data)
+			{
+				Log::coreWarn("Skipping invalid image {0}", file.string());
+				continue;
+			}
+			auto& sprite = sprites.emplace_back(SpriteImage { file.stem().string(), width, height });
+			sprite.pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+			stbi_image_free(data);
+		}
+		if (sprites.empty())
+		{
+			Log::coreWarn("No image to pack in {0}", folder.string());
+			return false;
+		}
+
+		// Tallest first, the skyline stays flat
+		std::ranges::stable_sort(sprites, std::greater {}, &SpriteImage::height);
+
+		// Smallest power of two size, grown one side at a time
+		int width = minAtlasSize;
+		int height = minAtlasSize;
+		while (!PackSprites(sprites, width, height))
+		{
+			if (width == maxAtlasSize && height == maxAtlasSize)
+			{
+				Log::coreError("Sprites of {0} do not fit in a {1}x{1} atlas", folder.string(), maxAtlasSize);
+				return false;
+			}
+			if (width <= height)
+				width *= 2;
+			else
+				height *= 2;
+		}
+
+		TextureData texture;
+		texture.format = TextureFormat::RGBA8;
+		texture.levels.push_back({ static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0, static_cast<uint64_t>(width) * height * 4 });
+		texture.bytes.resize(texture.levels.front().size);
+
+		Json::Value root;
+		root["width"] = width;
+		root["height"] = height;
+		auto& regions = root["regions"];
+		for (const auto& sprite : sprites)
+		{
+			CopySprite(sprite, texture.bytes, width);
+
+			auto& region = regions[sprite.name];
+			region.append(sprite.position.x);
+			region.append(sprite.position.y);
+			region.append(sprite.width);
+			region.append(sprite.height);
+		}
+
+		auto texturePath = atlasPath;
+		texturePath.replace_extension(".ktx2");
+		std::ofstream file(atlasPath);
+		if (!SaveTextureContainer(texturePath.string(), texture) || !file.is_open())
+		{
+			Log::coreError("Could not write atlas {0}", atlasPath.string());
+			return false;
+		}
+		file << root;
+
+		Log::coreInfo("Packed {0} sprites in a {1}x{2} atlas", sprites.size(), width, height);
+		return true;
+	}
+
+	std::unique_ptr<TextureAtlas> TextureAtlas::load(const std::filesystem::path& atlasPath, std::shared_ptr<Texture2D> texture)
+	{
+		std::unordered_map<std::string, AtlasRegion> regions;
+
+		Json::Value root;
+		std::ifstream file(atlasPath);
+		std::string err;
+		const Json::CharReaderBuilder builder;
+		if (!file.is_open() || !Json::parseFromStream(builder, file, &root, &err))
+		{
+			Log::coreError("Could not load atlas {0} : {1}", atlasPath.string(), err);
+			return std::make_unique<TextureAtlas>(std::move(texture), std::move(regions));
+		}
+
+		const glm::vec2 size { root["width"].asFloat(), root["height"].asFloat() };
+		const auto& nodes = root["regions"];
+		for (const auto& name : nodes.getMemberNames())
+		{
+			const auto& node = nodes[name];
+			const glm::ivec4 pixels { node[0].asInt(), node[1].asInt(), node[2].asInt(), node[3].asInt() };
+			regions[name] = { pixels, glm::vec4(pixels) / glm::vec4(size, size) };
+		}
+		return std::make_unique<TextureAtlas>(std::move(texture), std::move(regions));
+	}
+}
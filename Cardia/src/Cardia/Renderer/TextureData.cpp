@@ -0,0 +1,569 @@
+#include "cdpch.hpp"
+#include "Cardia/Renderer/TextureData.hpp"
+#include "Cardia/Core/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <string_view>
+
+
+namespace Cardia
+{
+	namespace
+	{
+		struct Ktx2Header
+		{
+			std::array<uint8_t, 12> identifier;
+			uint32_t vkFormat;
+			uint32_t typeSize;
+			uint32_t pixelWidth;
+			uint32_t pixelHeight;
+			uint32_t pixelDepth;
+			uint32_t layerCount;
+			uint32_t faceCount;
+			uint32_t levelCount;
+			uint32_t supercompressionScheme;
+			uint32_t dfdByteOffset;
+			uint32_t dfdByteLength;
+			uint32_t kvdByteOffset;
+			uint32_t kvdByteLength;
+			uint64_t sgdByteOffset;
+			uint64_t sgdByteLength;
+		};
+
+		struct Ktx2Level
+		{
+			uint64_t byteOffset;
+			uint64_t byteLength;
+			uint64_t uncompressedByteLength;
+		};
+
+		struct DdsHeader
+		{
+			uint32_t magic;
+			uint32_t size;
+			uint32_t flags;
+			uint32_t height;
+			uint32_t width;
+			uint32_t pitchOrLinearSize;
+			uint32_t depth;
+			uint32_t mipMapCount;
+			std::array<uint32_t, 11> reserved;
+			uint32_t pixelFormatSize;
+			uint32_t pixelFormatFlags;
+			uint32_t fourCC;
+			uint32_t rgbBitCount;
+			std::array<uint32_t, 4> masks;
+			std::array<uint32_t, 4> caps;
+			uint32_t reserved2;
+		};
+
+		struct DdsHeaderDx10
+		{
+			uint32_t dxgiFormat;
+			uint32_t resourceDimension;
+			uint32_t miscFlag;
+			uint32_t arraySize;
+			uint32_t miscFlags2;
+		};
+
+		constexpr std::array<uint8_t, 12> ktx2Identifier { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+		constexpr uint32_t ddsMagic = 0x20534444; // "DDS "
+		constexpr uint32_t maxTextureSize = 16384; // What GL 4.6 drivers commonly allow
+
+		constexpr uint32_t FourCC(const char (&code)[5])
+		{
+			return static_cast<uint32_t>(code[0]) | static_cast<uint32_t>(code[1]) << 8 |
+				static_cast<uint32_t>(code[2]) << 16 | static_cast<uint32_t>(code[3]) << 24;
+		}
+
+		TextureFormat FromVkFormat(uint32_t format)
+		{
+			switch (format)
+			{
+				case 9:		return TextureFormat::R8; // VK_FORMAT_R8_UNORM
+				case 16:	return TextureFormat::RG8; // VK_FORMAT_R8G8_UNORM
+				case 23:	return TextureFormat::RGB8; // VK_FORMAT_R8G8B8_UNORM
+				case 37:	return TextureFormat::RGBA8; // VK_FORMAT_R8G8B8A8_UNORM
+				case 131:	return TextureFormat::BC1; // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+				case 133:	return TextureFormat::BC1A; // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+				case 137:	return TextureFormat::BC3; // VK_FORMAT_BC3_UNORM_BLOCK
+				case 139:	return TextureFormat::BC4; // VK_FORMAT_BC4_UNORM_BLOCK
+				case 141:	return TextureFormat::BC5; // VK_FORMAT_BC5_UNORM_BLOCK
+				case 145:	return TextureFormat::BC7; // VK_FORMAT_BC7_UNORM_BLOCK
+				default:	return TextureFormat::None;
+			}
+		}
+
+		TextureFormat FromDxgiFormat(uint32_t format)
+		{
+			switch (format)
+			{
+				case 61:	return TextureFormat::R8; // DXGI_FORMAT_R8_UNORM
+				case 49:	return TextureFormat::RG8; // DXGI_FORMAT_R8G8_UNORM
+				case 28:	return TextureFormat::RGBA8; // DXGI_FORMAT_R8G8B8A8_UNORM
+				case 71:	return TextureFormat::BC1A; // DXGI_FORMAT_BC1_UNORM
+				case 77:	return TextureFormat::BC3; // DXGI_FORMAT_BC3_UNORM
+				case 80:	return TextureFormat::BC4; // DXGI_FORMAT_BC4_UNORM
+				case 83:	return TextureFormat::BC5; // DXGI_FORMAT_BC5_UNORM
+				case 98:	return TextureFormat::BC7; // DXGI_FORMAT_BC7_UNORM
+				default:	return TextureFormat::None;
+			}
+		}
+
+		TextureFormat FromFourCC(uint32_t fourCC)
+		{
+			switch (fourCC)
+			{
+				case FourCC("DXT1"):	return TextureFormat::BC1A;
+				case FourCC("DXT5"):	return TextureFormat::BC3;
+				case FourCC("ATI1"):
+				case FourCC("BC4U"):	return TextureFormat::BC4;
+				case FourCC("ATI2"):
+				case FourCC("BC5U"):	return TextureFormat::BC5;
+				default:		return TextureFormat::None;
+			}
+		}
+
+		template<typename T>
+		bool Read(const std::vector<uint8_t>& file, uint64_t offset, T& value)
+		{
+			if (offset + sizeof(T) > file.size())
+				return false;
+			std::memcpy(&value, file.data() + offset, sizeof(T));
+			return true;
+		}
+
+		// Rejects what glTextureStorage2D would, before trusting any other field of the file
+		bool IsValidSize(uint32_t width, uint32_t height, uint32_t levelCount)
+		{
+			if (width == 0 || height == 0 || width > maxTextureSize || height > maxTextureSize)
+			{
+				Log::coreWarn("Invalid texture size {0}x{1}", width, height);
+				return false;
+			}
+			if (levelCount > MipLevelCount(width, height))
+			{
+				Log::coreWarn("{0} mip levels for a {1}x{2} texture", levelCount, width, height);
+				return false;
+			}
+			return true;
+		}
+
+		// KTXorientation is "rd" when missing: rows are stored top-down unless its second letter says "u"
+		bool IsKtx2TopDown(const std::vector<uint8_t>& file, const Ktx2Header& header)
+		{
+			constexpr std::string_view orientationKey = "KTXorientation";
+			const uint64_t end = static_cast<uint64_t>(header.kvdByteOffset) + header.kvdByteLength;
+			if (end > file.size())
+				return true;
+
+			for (uint64_t offset = header.kvdByteOffset; offset + sizeof(uint32_t) <= end;)
+			{
+				uint32_t length = 0;
+				Read(file, offset, length);
+				offset += sizeof(uint32_t);
+				if (length > end - offset)
+					break;
+
+				// Key and value are both null terminated
+				const std::string_view entry(reinterpret_cast<const char*>(file.data() + offset), length);
+				const auto keyEnd = entry.find('\0');
+				if (keyEnd != std::string_view::npos && entry.substr(0, keyEnd) == orientationKey)
+				{
+					const std::string_view value = entry.substr(keyEnd + 1);
+					return value.size() < 2 || value[1] != 'u';
+				}
+				offset += (length + 3) & ~3u;
+			}
+			return true;
+		}
+
+		// BC1 color indices: one byte per row of the block
+		void FlipBc1Rows(uint8_t* block, uint32_t rows)
+		{
+			std::reverse(block + 4, block + 4 + rows);
+		}
+
+		// BC4 indices: 48 bits after the two endpoints, 12 bits per row of the block
+		void FlipBc4Rows(uint8_t* block, uint32_t rows)
+		{
+			uint64_t bits = 0;
+			std::memcpy(&bits, block + 2, 6);
+			std::array<uint64_t, 4> blockRows {};
+			for (uint32_t row = 0; row < 4; ++row)
+				blockRows[row] = bits >> (row * 12) & 0xfff;
+			std::reverse(blockRows.begin(), blockRows.begin() + rows);
+
+			bits = 0;
+			for (uint32_t row = 0; row < 4; ++row)
+				bits |= blockRows[row] << (row * 12);
+			std::memcpy(block + 2, &bits, 6);
+		}
+
+		// Flips the first rows of a 4x4 block, false for BC7 whose partitions cannot be flipped by moving bits
+		bool FlipBlockRows(TextureFormat format, uint8_t* block, uint32_t rows)
+		{
+			switch (format)
+			{
+				case TextureFormat::BC1:
+				case TextureFormat::BC1A:	FlipBc1Rows(block, rows); return true;
+				case TextureFormat::BC4:	FlipBc4Rows(block, rows); return true;
+				case TextureFormat::BC3:	FlipBc4Rows(block, rows); FlipBc1Rows(block + 8, rows); return true;
+				case TextureFormat::BC5:	FlipBc4Rows(block, rows); FlipBc4Rows(block + 8, rows); return true;
+				default:			return false;
+			}
+		}
+
+		// Turns a top-down level bottom-up. Compressed levels swap their block rows and the rows inside every block,
+		// which is exact for heights that are multiples of 4 and for the single block row of the smallest mips.
+		bool FlipLevel(TextureFormat format, uint8_t* level, uint32_t width, uint32_t height)
+		{
+			const bool compressed = TextureFormatIsCompressed(format);
+			const uint32_t rowCount = compressed ? (height + 3) / 4 : height;
+			const auto rowSize = static_cast<size_t>(TextureLevelSize(format, width, compressed ? 4 : 1));
+			for (uint32_t row = 0; row < rowCount / 2; ++row)
+				std::swap_ranges(level + row * rowSize, level + (row + 1) * rowSize, level + (rowCount - 1 - row) * rowSize);
+
+			if (!compressed)
+				return true;
+
+			const size_t blockSize = TextureLevelSize(format, 4, 4);
+			const uint32_t blockRows = rowCount == 1 ? height : 4;
+			for (size_t block = 0; block < rowCount * rowSize / blockSize; ++block)
+			{
+				if (!FlipBlockRows(format, level + block * blockSize, blockRows))
+					return false;
+			}
+			return true;
+		}
+
+		// Every level of data, false when the format cannot be flipped
+		bool FlipLevels(TextureData& data)
+		{
+			for (const auto& level : data.levels)
+			{
+				if (!FlipLevel(data.format, data.bytes.data() + level.offset, level.width, level.height))
+				{
+					Log::coreWarn("BC7 textures cannot be flipped on load, export them bottom-up (KTXorientation \"ru\")");
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool LoadKtx2(const std::vector<uint8_t>& file, TextureData& data)
+		{
+			Ktx2Header header {};
+			if (!Read(file, 0, header) || header.identifier != ktx2Identifier)
+				return false;
+			if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1)
+			{
+				Log::coreWarn("Only 2D KTX2 textures are supported");
+				return false;
+			}
+			if (header.supercompressionScheme != 0)
+			{
+				Log::coreWarn("Supercompressed KTX2 textures are not supported");
+				return false;
+			}
+
+			data.format = FromVkFormat(header.vkFormat);
+			if (data.format == TextureFormat::None)
+			{
+				Log::coreWarn("Unsupported KTX2 format {0}", header.vkFormat);
+				return false;
+			}
+
+			// A level count of 0 asks for the chain to be generated from the single level stored
+			const uint32_t levelCount = std::max(header.levelCount, 1u);
+			if (!IsValidSize(header.pixelWidth, header.pixelHeight, levelCount))
+				return false;
+
+			// Everything the file claims is checked against its size before anything is allocated
+			std::vector<Ktx2Level> levels(levelCount);
+			uint64_t total = 0;
+			for (uint32_t level = 0; level < levelCount; ++level)
+			{
+				if (!Read(file, sizeof(Ktx2Header) + level * sizeof(Ktx2Level), levels[level]))
+					return false;
+
+				const uint64_t size = TextureLevelSize(data.format, std::max(header.pixelWidth >> level, 1u), std::max(header.pixelHeight >> level, 1u));
+				if (levels[level].byteLength < size || levels[level].byteOffset > file.size() || size > file.size() - levels[level].byteOffset)
+					return false;
+				total += size;
+			}
+
+			data.bytes.reserve(total);
+			for (uint32_t level = 0; level < levelCount; ++level)
+			{
+				const uint32_t width = std::max(header.pixelWidth >> level, 1u);
+				const uint32_t height = std::max(header.pixelHeight >> level, 1u);
+				const uint64_t size = TextureLevelSize(data.format, width, height);
+
+				data.levels.push_back({ width, height, data.bytes.size(), size });
+				const auto begin = file.begin() + static_cast<std::ptrdiff_t>(levels[level].byteOffset);
+				data.bytes.insert(data.bytes.end(), begin, begin + static_cast<std::ptrdiff_t>(size));
+			}
+			if (IsKtx2TopDown(file, header))
+				FlipLevels(data);
+			return true;
+		}
+
+		bool LoadDds(const std::vector<uint8_t>& file, TextureData& data)
+		{
+			constexpr uint32_t fourCCFlag = 0x4;
+			constexpr uint32_t cubemapFlag = 0x200;
+
+			DdsHeader header {};
+			if (!Read(file, 0, header) || header.magic != ddsMagic)
+				return false;
+			if (header.caps[1] & cubemapFlag || header.depth > 1)
+			{
+				Log::coreWarn("Only 2D DDS textures are supported");
+				return false;
+			}
+			if (!(header.pixelFormatFlags & fourCCFlag))
+			{
+				Log::coreWarn("Uncompressed DDS textures need a DX10 header");
+				return false;
+			}
+
+			uint64_t offset = sizeof(DdsHeader);
+			if (header.fourCC == FourCC("DX10"))
+			{
+				DdsHeaderDx10 dx10 {};
+				if (!Read(file, offset, dx10))
+					return false;
+				if (dx10.arraySize > 1)
+				{
+					Log::coreWarn("Only 2D DDS textures are supported");
+					return false;
+				}
+				offset += sizeof(DdsHeaderDx10);
+				data.format = FromDxgiFormat(dx10.dxgiFormat);
+			}
+			else
+			{
+				data.format = FromFourCC(header.fourCC);
+			}
+			if (data.format == TextureFormat::None)
+			{
+				Log::coreWarn("Unsupported DDS format");
+				return false;
+			}
+
+			// Levels follow each other, largest first
+			const uint64_t start = offset;
+			const uint32_t levelCount = std::max(header.mipMapCount, 1u);
+			if (!IsValidSize(header.width, header.height, levelCount))
+				return false;
+			for (uint32_t level = 0; level < levelCount; ++level)
+			{
+				const uint32_t width = std::max(header.width >> level, 1u);
+				const uint32_t height = std::max(header.height >> level, 1u);
+				const uint64_t size = TextureLevelSize(data.format, width, height);
+				if (offset > file.size() || size > file.size() - offset)
+					return false;
+
+				data.levels.push_back({ width, height, offset - start, size });
+				offset += size;
+			}
+			data.bytes.assign(file.begin() + static_cast<std::ptrdiff_t>(start), file.begin() + static_cast<std::ptrdiff_t>(offset));
+			// DDS has no orientation field, its rows are always top-down
+			FlipLevels(data);
+			return true;
+		}
+
+		uint32_t ToVkFormat(TextureFormat format)
+		{
+			switch (format)
+			{
+				case TextureFormat::R8:		return 9;
+				case TextureFormat::RG8:	return 16;
+				case TextureFormat::RGB8:	return 23;
+				case TextureFormat::RGBA8:	return 37;
+				default:			return 0;
+			}
+		}
+
+		uint32_t ChannelCount(TextureFormat format)
+		{
+			return static_cast<uint32_t>(TextureLevelSize(format, 1, 1));
+		}
+
+		template<typename T>
+		void Write(std::vector<uint8_t>& file, const T& value)
+		{
+			const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+			file.insert(file.end(), bytes, bytes + sizeof(T));
+		}
+
+		// Basic data format descriptor of an unsigned normalized linear format, one 8-bit sample per channel
+		std::vector<uint8_t> MakeKtx2Descriptor(TextureFormat format)
+		{
+			constexpr std::array<uint32_t, 4> channelIds { 0, 1, 2, 15 }; // R, G, B, A
+			const uint32_t channels = ChannelCount(format);
+			const uint32_t blockSize = 24 + 16 * channels;
+
+			std::vector<uint8_t> descriptor;
+			Write(descriptor, 4 + blockSize); // Total size
+			Write(descriptor, 0u); // Khronos basic descriptor
+			Write(descriptor, 2u | blockSize << 16); // Version 2
+			Write(descriptor, 1u | 1u << 8 | 1u << 16); // RGBSDA model, BT.709 primaries, linear transfer
+			Write(descriptor, 0u); // 1x1 texel blocks
+			Write(descriptor, channels); // Bytes in plane 0
+			Write(descriptor, 0u);
+			for (uint32_t channel = 0; channel < channels; ++channel)
+			{
+				Write(descriptor, channel * 8 | 7u << 16 | channelIds[channel] << 24); // Bit offset, bit length - 1, channel
+				Write(descriptor, 0u);
+				Write(descriptor, 0u); // Lower
+				Write(descriptor, 255u); // Upper
+			}
+			return descriptor;
+		}
+	}
+
+	bool TextureFormatIsCompressed(TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::BC1:
+			case TextureFormat::BC1A:
+			case TextureFormat::BC3:
+			case TextureFormat::BC4:
+			case TextureFormat::BC5:
+			case TextureFormat::BC7:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	bool TextureFormatHasAlpha(TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::RGBA8:
+			case TextureFormat::BC1A:
+			case TextureFormat::BC3:
+			case TextureFormat::BC7:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	uint64_t TextureLevelSize(TextureFormat format, uint32_t width, uint32_t height)
+	{
+		const uint64_t blocks = static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4);
+		const uint64_t pixels = static_cast<uint64_t>(width) * height;
+		switch (format)
+		{
+			case TextureFormat::R8:		return pixels;
+			case TextureFormat::RG8:	return pixels * 2;
+			case TextureFormat::RGB8:	return pixels * 3;
+			case TextureFormat::RGBA8:	return pixels * 4;
+			case TextureFormat::BC1:
+			case TextureFormat::BC1A:
+			case TextureFormat::BC4:	return blocks * 8;
+			case TextureFormat::BC3:
+			case TextureFormat::BC5:
+			case TextureFormat::BC7:	return blocks * 16;
+			default:			return 0;
+		}
+	}
+
+	uint32_t MipLevelCount(uint32_t width, uint32_t height)
+	{
+		return std::bit_width(std::max({ width, height, 1u }));
+	}
+
+	bool IsTextureContainer(const std::string& path)
+	{
+		auto extension = std::filesystem::path(path).extension().string();
+		std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return extension == ".ktx2" || extension == ".dds";
+	}
+
+	bool LoadTextureContainer(const std::string& path, TextureData& data)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+		const std::vector<uint8_t> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+		// Told apart by their magic, not the extension
+		uint32_t magic = 0;
+		Read(file, 0, magic);
+
+		data = TextureData();
+		const bool loaded = magic == ddsMagic ? LoadDds(file, data) : LoadKtx2(file, data);
+		if (!loaded)
+			data = TextureData();
+		return loaded;
+	}
+
+	bool SaveTextureContainer(const std::string& path, const TextureData& data)
+	{
+		if (ToVkFormat(data.format) == 0 || data.levels.empty())
+		{
+			Log::coreError("Only uncompressed textures can be saved");
+			return false;
+		}
+
+		const auto descriptor = MakeKtx2Descriptor(data.format);
+		// Rows are stored bottom-up, readers that honour the orientation flip them back
+		constexpr char orientation[] = "KTXorientation\0ru"; // Key and value, both null terminated
+		const uint32_t keyValueSize = 4 + sizeof(orientation);
+		const uint32_t keyValuePadded = (keyValueSize + 3) & ~3u;
+
+		const auto levelCount = static_cast<uint32_t>(data.levels.size());
+		const uint32_t descriptorOffset = sizeof(Ktx2Header) + levelCount * sizeof(Ktx2Level);
+		const uint32_t keyValueOffset = descriptorOffset + static_cast<uint32_t>(descriptor.size());
+		uint64_t levelOffset = keyValueOffset + keyValuePadded;
+
+		Ktx2Header header {};
+		header.identifier = ktx2Identifier;
+		header.vkFormat = ToVkFormat(data.format);
+		header.typeSize = 1;
+		header.pixelWidth = data.levels.front().width;
+		header.pixelHeight = data.levels.front().height;
+		header.faceCount = 1;
+		header.levelCount = levelCount;
+		header.dfdByteOffset = descriptorOffset;
+		header.dfdByteLength = static_cast<uint32_t>(descriptor.size());
+		header.kvdByteOffset = keyValueOffset;
+		header.kvdByteLength = keyValuePadded;
+
+		std::vector<uint8_t> file;
+		Write(file, header);
+		// The smallest level comes first in the file, the index still starts with level 0
+		std::vector<Ktx2Level> levels(levelCount);
+		for (uint32_t level = levelCount; level-- > 0;)
+		{
+			levels[level] = { levelOffset, data.levels[level].size, data.levels[level].size };
+			levelOffset += data.levels[level].size;
+		}
+		for (const auto& level : levels)
+			Write(file, level);
+		file.insert(file.end(), descriptor.begin(), descriptor.end());
+		Write(file, static_cast<uint32_t>(sizeof(orientation)));
+		file.insert(file.end(), orientation, orientation + sizeof(orientation));
+		file.resize(keyValueOffset + keyValuePadded);
+		for (uint32_t level = levelCount; level-- > 0;)
+		{
+			const auto begin = data.bytes.begin() + static_cast<std::ptrdiff_t>(data.levels[level].offset);
+			file.insert(file.end(), begin, begin + static_cast<std::ptrdiff_t>(data.levels[level].size));
+		}
+
+		std::ofstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+		stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+		return stream.good();
+	}
+}
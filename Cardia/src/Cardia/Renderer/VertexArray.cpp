@@ -2,6 +2,7 @@
 #include "Cardia/Renderer/VertexArray.hpp"
 #include "Cardia/Renderer/Renderer.hpp"
 #include "Cardia/Renderer/OpenGL/OpenGLVertexArray.hpp"
+#include "Cardia/Renderer/Null/NullVertexArray.hpp"
 
 
 namespace Cardia
@@ -13,9 +14,7 @@ namespace Cardia
 		switch (renderer)
 		{
 			case RenderAPI::API::None:
-				Log::coreError("{0} is not supported for the moment !", renderer);
-				cdCoreAssert(false, "Invalid API provided");
-				return nullptr;
+				return std::make_unique<NullVertexArray>();
 			case RenderAPI::API::OpenGL:
 				return std::make_unique<OpenGLVertexArray>();
 			default:
@@ -196,6 +196,7 @@ namespace Cardia::Serialization
 		Json::Value node;
 
 		node["path"] = AssetsManager::GetPathFromAsset(component.meshRenderer->GetMesh()).string();
+		node["packedVertices"] = component.meshRenderer->GetVertexFormat() == VertexFormat::Packed;
 		Json::Value materials;
 		for (const auto& material : component.meshRenderer->GetMesh()->GetMaterials()) {
 			materials.append(AssetsManager::GetPathFromAsset(material).string());
@@ -213,6 +214,12 @@ namespace Cardia::Serialization
 
 		node["color"] = ToJson(component.color);
 		node["texture"] = AssetsManager::GetPathFromAsset(component.texture).string();
+		node["uvRect"] = ToJson(component.uvRect);
+		if (component.atlas)
+		{
+			node["atlas"] = AssetsManager::GetPathFromAsset(component.atlas).string();
+			node["region"] = component.region;
+		}
 		node["tillingFactor"] = component.tillingFactor;
 		node["zIndex"] = component.zIndex;
 
@@ -236,6 +243,8 @@ namespace Cardia::Serialization
 		node["orthoNear"] = ortho.y;
 		node["orthoFar"] = ortho.z;
 
+		node["depthPrePass"] = component.camera.isDepthPrePass();
+
 		auto idx = static_cast<uint32_t>(entity);
 		m_Root[idx][Component::Camera::ClassName()] = node;
 	}
@@ -378,6 +387,16 @@ namespace Cardia::Serialization
 				{
 					spriteRenderer.texture = std::move(texture);
 				}
+				if (node[currComponent].isMember("uvRect"))
+					spriteRenderer.uvRect = node[currComponent]["uvRect"].as<glm::vec4>();
+
+				// Regions are looked up again, the atlas may have been repacked since
+				if (node[currComponent].isMember("atlas"))
+				{
+					const auto region = node[currComponent]["region"].asString();
+					if (!spriteRenderer.setRegion(AssetsManager::Load<TextureAtlas>(node[currComponent]["atlas"].asString()), region))
+						Log::coreWarn("Atlas region {0} not found", region);
+				}
 
 				spriteRenderer.tillingFactor = node[currComponent]["tillingFactor"].asFloat();
 				spriteRenderer.zIndex = node[currComponent]["zIndex"].asInt();
@@ -388,7 +407,8 @@ namespace Cardia::Serialization
 				auto& meshRenderer = entity.addComponent<Component::MeshRendererC>();
 
 				auto mesh = AssetsManager::Load<Mesh>(node[currComponent]["path"].asString());
-				meshRenderer.meshRenderer->SubmitMesh(mesh);
+				const bool packedVertices = node[currComponent]["packedVertices"].asBool();
+				meshRenderer.meshRenderer->SubmitMesh(mesh, packedVertices ? VertexFormat::Packed : VertexFormat::Standard);
 
 				auto& materials = node[currComponent]["materials"];
 				for (const auto& texturePath : materials) {
@@ -416,6 +436,8 @@ namespace Cardia::Serialization
 				auto oFar = node[currComponent]["orthoFar"].asFloat();
 				camera.camera.SetOrthographic(oSize, oNear, oFar);
 
+				camera.camera.setDepthPrePass(node[currComponent]["depthPrePass"].asBool());
+
 				camera.camera.SetProjectionType(
 					static_cast<SceneCamera::ProjectionType>(node["camera"]["type"].asInt()));
 			}
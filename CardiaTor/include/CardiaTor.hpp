@@ -2,6 +2,8 @@
 
 
 #include <Cardia.hpp>
+#include <deque>
+#include <optional>
 #include <random>
 #include <stack>
 
@@ -28,8 +30,12 @@ namespace Cardia
 		void OnEvent(Event& event) override;
 		void OnImGuiDraw() override;
 		void SetSelectedEntity(Entity entity);
+		// The selected entity or one of the marquee selection
+		bool IsSelected(entt::entity entity) const;
 
 		Scene* GetCurrentScene() override { return m_CurrentScene.get(); }
+		EditorCamera& GetEditorCamera() { return m_EditorCamera; }
+		const RenderGraph& GetRenderGraph() const { return m_RenderGraph; }
 
 	private:
 		void EnableDocking();
@@ -41,9 +47,26 @@ namespace Cardia
 		void ReloadScene();
 		void UndoCommand();
 		void RedoCommand();
+
+		enum class PickKind
+		{
+			Hover, Click, Marquee
+		};
+
+		struct PickResult
+		{
+			PickKind kind;
+			std::vector<int> entityIDs; // One per picked pixel, -1 where no entity was drawn
+		};
+
+		glm::ivec2 ToViewportPixel(const glm::vec2& screenPosition) const;
+		void ResolvePick(const PickResult& result);
+		void SelectFromViewport(Entity entity);
+
 		std::shared_ptr<Texture2D> m_IconPlay;
 		std::shared_ptr<Texture2D> m_IconStop;
 		std::unique_ptr<Framebuffer> m_Framebuffer;
+		RenderGraph m_RenderGraph;
 
 		std::unique_ptr<Scene> m_CurrentScene;
 		std::unique_ptr<Scene> m_LastEditorScene;
@@ -55,6 +78,15 @@ namespace Cardia
 
 		Entity m_HoveredEntity;
 		Entity m_SelectedEntity;
+		std::vector<entt::entity> m_MarqueeSelection;
+
+		// The entity id target is read back asynchronously, only when the mouse moved or clicked
+		std::deque<PickKind> m_PendingPicks; // Back end only, in request order
+		std::vector<PickResult> m_PickResults; // Written by the back end, resolved once synced
+		glm::ivec2 m_LastPickPosition { -1, -1 };
+		bool m_ClickPickRequested = false;
+		std::optional<glm::vec2> m_MarqueeStart; // Screen position where a left drag began
+		std::optional<PixelRegion> m_MarqueeRequest;
 
 		glm::vec2 m_SceneSize {};
 
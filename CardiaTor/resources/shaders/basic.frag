@@ -12,24 +12,203 @@ struct Vertex {
     float tilingFactor;
 };
 
+struct Light {
+    vec4 positionAndType;
+    vec4 directionAndRange;
+    vec4 colorAndCutOff;
+};
+
 layout (location = 0) in Vertex o_Vertex;
-layout (location = 5) in flat float o_EntityID;
+layout (location = 5) in flat int o_EntityID;
+layout (location = 6) in flat int o_TextureIndex;
+
+// Directional lights first, then point and spot lights reached through the clusters
+layout(std430, binding = 0) readonly buffer LightBuffer {
+    Light lights[];
+};
+
+// x: offset into lightIndices, y: light count
+layout(std430, binding = 6) readonly buffer ClusterBuffer {
+    uvec2 clusters[];
+};
+
+layout(std430, binding = 7) readonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
+
+// Per-frame data, uploaded once by Renderer2D
+layout(std140, binding = 0) uniform FrameData {
+    mat4 u_ViewProjection;
+    mat4 u_View;
+    vec4 u_ViewPosition;
+    vec4 u_ClusterDepth; // x: scale, y: bias, z: logarithmic slices
+    ivec4 u_LightCounts; // x: all lights, y: directional lights
+};
+
+// Injected with the feature defines, clamped to the fragment texture units of the driver
+#ifndef CD_MAX_TEXTURE_SLOTS
+#define CD_MAX_TEXTURE_SLOTS 32
+#endif
+
+uniform sampler2D u_Textures[CD_MAX_TEXTURE_SLOTS];
+
+// Sampler array indices must be dynamically uniform, o_TextureIndex varies inside a draw.
+// Every case indexes with a constant instead, the switch only picks which one runs.
+// Derivatives are taken before it, they are undefined inside non-uniform control flow.
+// GL guarantees 16 units, the cases past 16 are only compiled when the array has them.
+vec4 SampleTexture(int index, vec2 uv) {
+    vec2 dx = dFdx(uv);
+    vec2 dy = dFdy(uv);
+    switch (index) {
+        case 0: return textureGrad(u_Textures[0], uv, dx, dy);
+        case 1: return textureGrad(u_Textures[1], uv, dx, dy);
+        case 2: return textureGrad(u_Textures[2], uv, dx, dy);
+        case 3: return textureGrad(u_Textures[3], uv, dx, dy);
+        case 4: return textureGrad(u_Textures[4], uv, dx, dy);
+        case 5: return textureGrad(u_Textures[5], uv, dx, dy);
+        case 6: return textureGrad(u_Textures[6], uv, dx, dy);
+        case 7: return textureGrad(u_Textures[7], uv, dx, dy);
+        case 8: return textureGrad(u_Textures[8], uv, dx, dy);
+        case 9: return textureGrad(u_Textures[9], uv, dx, dy);
+        case 10: return textureGrad(u_Textures[10], uv, dx, dy);
+        case 11: return textureGrad(u_Textures[11], uv, dx, dy);
+        case 12: return textureGrad(u_Textures[12], uv, dx, dy);
+        case 13: return textureGrad(u_Textures[13], uv, dx, dy);
+        case 14: return textureGrad(u_Textures[14], uv, dx, dy);
+        case 15: return textureGrad(u_Textures[15], uv, dx, dy);
+#if CD_MAX_TEXTURE_SLOTS > 16
+        case 16: return textureGrad(u_Textures[16], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 17
+        case 17: return textureGrad(u_Textures[17], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 18
+        case 18: return textureGrad(u_Textures[18], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 19
+        case 19: return textureGrad(u_Textures[19], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 20
+        case 20: return textureGrad(u_Textures[20], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 21
+        case 21: return textureGrad(u_Textures[21], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 22
+        case 22: return textureGrad(u_Textures[22], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 23
+        case 23: return textureGrad(u_Textures[23], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 24
+        case 24: return textureGrad(u_Textures[24], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 25
+        case 25: return textureGrad(u_Textures[25], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 26
+        case 26: return textureGrad(u_Textures[26], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 27
+        case 27: return textureGrad(u_Textures[27], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 28
+        case 28: return textureGrad(u_Textures[28], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 29
+        case 29: return textureGrad(u_Textures[29], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 30
+        case 30: return textureGrad(u_Textures[30], uv, dx, dy);
+#endif
+#if CD_MAX_TEXTURE_SLOTS > 31
+        case 31: return textureGrad(u_Textures[31], uv, dx, dy);
+#endif
+    }
+    return vec4(1.0f);
+}
 
-uniform sampler2D u_Texture;
-uniform vec3 u_ViewPosition;
+// Must match ClusteredLights.hpp
+const uvec3 clusterGrid = uvec3(16u, 9u, 24u);
 
-const vec3 lightDirection = normalize(-vec3(-0.2f, -1.0f, -0.3f)); // direction de la lumière
+const int PointLight = 1;
+const int SpotLight  = 2;
+
+// Used when the scene has no light at all
+const vec3 defaultLightDirection = normalize(-vec3(-0.2f, -1.0f, -0.3f));
+
+float Attenuation(Light light, vec3 fragPos) {
+    float range = light.directionAndRange.w;
+    float dist = length(light.positionAndType.xyz - fragPos);
+    return 1.0f / (1.0f + 0.045f * dist + 0.0075f * dist * dist) * max(smoothstep(1.0f, 0.0f, dist / range), 0.0f);
+}
+
+vec3 CalcDirLight(Light light, vec3 normal) {
+    float diffuse = max(dot(normal, -light.directionAndRange.xyz), 0.0f);
+    return light.colorAndCutOff.rgb * diffuse;
+}
+
+vec3 CalcPointLight(Light light, vec3 fragPos) {
+    return light.colorAndCutOff.rgb * Attenuation(light, fragPos);
+}
+
+vec3 CalcSpotLight(Light light, vec3 fragPos) {
+    vec3 lightDir = normalize(light.positionAndType.xyz - fragPos);
+    float theta = dot(lightDir, normalize(-light.directionAndRange.xyz));
+    float cutOff = light.colorAndCutOff.w;
+    float intensity = clamp((theta - (cutOff - 0.09f)) / 0.09f, 0.0f, 1.0f);
+    return light.colorAndCutOff.rgb * Attenuation(light, fragPos) * intensity;
+}
+
+uint ClusterIndex(vec3 fragPos) {
+    vec4 clip = u_ViewProjection * vec4(fragPos, 1.0f);
+    uvec2 tile = uvec2(clamp((clip.xy / clip.w * 0.5f + 0.5f) * vec2(clusterGrid.xy), vec2(0.0f), vec2(clusterGrid.xy) - 1.0f));
+
+    float viewDepth = -(u_View * vec4(fragPos, 1.0f)).z;
+    float depth = u_ClusterDepth.z > 0.5f ? log(max(viewDepth, 1e-4f)) : viewDepth;
+    uint slice = uint(clamp(depth * u_ClusterDepth.x - u_ClusterDepth.y, 0.0f, float(clusterGrid.z - 1u)));
+
+    return (slice * clusterGrid.y + tile.y) * clusterGrid.x + tile.x;
+}
+
+vec3 CalcLighting(vec3 normal, vec3 fragPos) {
+    if (u_LightCounts.x == 0)
+        return vec3(max(dot(normal, defaultLightDirection), 0.0f));
+
+    vec3 result = vec3(0.0f);
+    for (int i = 0; i < u_LightCounts.y; ++i)
+        result += CalcDirLight(lights[i], normal);
+
+    uvec2 cluster = clusters[ClusterIndex(fragPos)];
+    for (uint i = 0u; i < cluster.y; ++i) {
+        Light light = lights[lightIndices[cluster.x + i]];
+        int type = int(light.positionAndType.w);
+        if (type == PointLight)
+            result += CalcPointLight(light, fragPos);
+        else if (type == SpotLight)
+            result += CalcSpotLight(light, fragPos);
+    }
+    return result;
+}
 
 void main() {
-    if (o_Vertex.color.a == 0) {
+#ifdef CD_TEXTURED
+    vec4 color = SampleTexture(o_TextureIndex, o_Vertex.texturePosition) * o_Vertex.color;
+#else
+    vec4 color = o_Vertex.color;
+#endif
+
+#ifdef CD_ALPHA_TEST
+    if (color.a == 0.0f) {
         discard;
     }
+#endif
 
-    vec3 surfaceNormal = normalize(o_Vertex.normal);
-    float diffuse = max(dot(surfaceNormal, lightDirection), 0.0);
-    vec3 diffuseColor = vec3(1.0) * diffuse;
-
-    vec4 color = texture(u_Texture, o_Vertex.texturePosition) * o_Vertex.color;
-    OutColor = vec4(color.rgb * diffuseColor, color.a);
-    OutEntityID = int(o_EntityID);
-}
\ No newline at end of file
+#ifdef CD_LIT
+    vec3 lighting = CalcLighting(normalize(o_Vertex.normal), o_Vertex.fragPosition);
+    OutColor = vec4(color.rgb * lighting, color.a);
+#else
+    OutColor = color;
+#endif
+    OutEntityID = o_EntityID;
+}
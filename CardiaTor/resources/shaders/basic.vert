@@ -1,11 +1,28 @@
 #version 460 core
 
+#ifdef CD_INSTANCED
+// Unit quad
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_TexPos;
+
+// Per instance
+layout(location = 2) in vec4 a_TransformRow0;
+layout(location = 3) in vec4 a_TransformRow1;
+layout(location = 4) in vec4 a_TransformRow2;
+layout(location = 5) in vec4 a_Color;
+layout(location = 6) in vec4 a_UVRect;
+layout(location = 7) in float a_TilingFactor;
+layout(location = 8) in int a_EntityID;
+layout(location = 9) in int a_TextureIndex;
+#else
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
 layout(location = 2) in vec4 a_Color;
 layout(location = 3) in vec2 a_TexPos;
 layout(location = 4) in float a_TilingFactor;
-layout(location = 5) in float a_EntityID;
+layout(location = 5) in int a_TextureIndex;
+layout(location = 6) in int a_EntityID;
+#endif
 
 
 struct Vertex {
@@ -17,17 +34,46 @@ struct Vertex {
 };
 
 layout (location = 0) out Vertex o_Vertex;
-layout (location = 5) out flat float o_EntityID;
+layout (location = 5) out flat int o_EntityID;
+layout (location = 6) out flat int o_TextureIndex;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Model;
+// The depth pre-pass and the shading pass use different variants, both must land on the same depth
+invariant gl_Position;
 
+// Per-frame data, uploaded once by Renderer2D
+layout(std140, binding = 0) uniform FrameData {
+    mat4 u_ViewProjection;
+    mat4 u_View;
+    vec4 u_ViewPosition;
+    vec4 u_ClusterDepth; // x: scale, y: bias, z: logarithmic slices
+    ivec4 u_LightCounts; // x: all lights, y: directional lights
+};
+
+#ifdef CD_INSTANCED
+void main() {
+    mat4 model = transpose(mat4(a_TransformRow0, a_TransformRow1, a_TransformRow2, vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+    vec4 worldPosition = model * vec4(a_Position, 1.0f);
+
+    o_Vertex.fragPosition = worldPosition.xyz;
+    // The quad normal is +Z in model space, its world direction is orthogonal to both transformed quad axes
+    o_Vertex.normal = cross(model[0].xyz, model[1].xyz);
+    o_Vertex.color = a_Color;
+    o_Vertex.texturePosition = a_UVRect.xy + a_TexPos * a_UVRect.zw;
+    o_Vertex.tilingFactor = a_TilingFactor;
+    o_EntityID = a_EntityID;
+    o_TextureIndex = a_TextureIndex;
+    gl_Position = u_ViewProjection * worldPosition;
+}
+#else
+// Batched geometry is already in world space, normals included
 void main() {
-    o_Vertex.fragPosition = vec3(u_Model * vec4(a_Position, 1.0f));
-    o_Vertex.normal = mat3(transpose(inverse(u_Model))) * a_Normal;
+    o_Vertex.fragPosition = a_Position;
+    o_Vertex.normal = a_Normal;
     o_Vertex.color = a_Color;
     o_Vertex.texturePosition = a_TexPos;
     o_Vertex.tilingFactor = a_TilingFactor;
     o_EntityID = a_EntityID;
-    gl_Position = u_ViewProjection * u_Model * vec4(a_Position, 1.0f);
-}
\ No newline at end of file
+    o_TextureIndex = a_TextureIndex;
+    gl_Position = u_ViewProjection * vec4(a_Position, 1.0f);
+}
+#endif
\ No newline at end of file
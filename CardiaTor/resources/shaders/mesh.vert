@@ -0,0 +1,56 @@
+#version 460 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec3 a_Normal;
+layout(location = 2) in vec4 a_Color;
+layout(location = 3) in vec2 a_TexPos;
+layout(location = 4) in float a_TilingFactor;
+
+
+struct Vertex {
+    vec4 color;
+    vec3 normal;
+    vec3 fragPosition;
+    vec2 texturePosition;
+    float tilingFactor;
+};
+
+// One entry per indirect command, indexed through its baseInstance
+struct DrawData {
+    mat4 model;
+    mat3 normalMatrix; // transpose(inverse(model)), computed once per draw on the CPU
+    int textureIndex;
+    int entityID;
+};
+
+layout(std430, binding = 1) readonly buffer DrawBuffer {
+    DrawData draws[];
+};
+
+layout (location = 0) out Vertex o_Vertex;
+layout (location = 5) out flat int o_EntityID;
+layout (location = 6) out flat int o_TextureIndex;
+
+// The depth pre-pass and the shading pass use different variants, both must land on the same depth
+invariant gl_Position;
+
+// Per-frame data, uploaded once by Renderer2D
+layout(std140, binding = 0) uniform FrameData {
+    mat4 u_ViewProjection;
+    mat4 u_View;
+    vec4 u_ViewPosition;
+    vec4 u_ClusterDepth; // x: scale, y: bias, z: logarithmic slices
+    ivec4 u_LightCounts; // x: all lights, y: directional lights
+};
+
+void main() {
+    DrawData draw = draws[gl_BaseInstance];
+    o_Vertex.fragPosition = vec3(draw.model * vec4(a_Position, 1.0f));
+    o_Vertex.normal = draw.normalMatrix * a_Normal;
+    o_Vertex.color = a_Color;
+    o_Vertex.texturePosition = a_TexPos;
+    o_Vertex.tilingFactor = a_TilingFactor;
+    o_EntityID = draw.entityID;
+    o_TextureIndex = draw.textureIndex;
+    gl_Position = u_ViewProjection * vec4(o_Vertex.fragPosition, 1.0f);
+}
@@ -40,7 +40,8 @@ namespace Cardia
 		m_IconStop = AssetsManager::Load<Texture2D>("resources/icons/pause.png");
 
 		FramebufferSpec spec{ window.getWidth(), window.getHeight() };
-		spec.attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::RED_INTEGER, FramebufferTextureFormat::Depth };
+		// Only what ImGui displays, the other scene targets are transient textures of the render graph
+		spec.attachments = { FramebufferTextureFormat::RGBA8 };
 		m_Framebuffer = Framebuffer::create(spec);
 
 		ImGuiIO &io = ImGui::GetIO();
@@ -54,41 +55,141 @@ namespace Cardia
 
 	void CardiaTor::OnUpdate()
 	{
-		m_Framebuffer->Bind();
-		RenderAPI::get().setClearColor({0.2f, 0.2f, 0.2f, 1});
-		RenderAPI::get().clear();
-		m_Framebuffer->ClearAttachment(1, -1);
-
+		auto[mx, my] = ImGui::GetMousePos();
+		const glm::ivec2 mouse = ToViewportPixel({ mx, my });
+		glm::vec2 viewportSize = glm::vec2(m_ViewportBounds.z - m_ViewportBounds.x, m_ViewportBounds.w - m_ViewportBounds.y);
 
-		if (m_EditorState == EditorState::Edit)
+		// Ids are read back by the render thread, they are turned into entities once a later frame has been replayed
+		const bool mouseInViewport = m_CurrentScene && mouse.x >= 0 && mouse.y >= 0 && mouse.x < (int)viewportSize.x && mouse.y < (int)viewportSize.y;
+		std::vector<std::pair<PickKind, PixelRegion>> picks;
+		if (mouseInViewport && (mouse != m_LastPickPosition || m_ClickPickRequested))
 		{
-			m_CurrentScene->OnUpdateEditor(m_EditorCamera.GetCamera(), m_EditorCamera.GetTransform());
-			m_EditorCamera.OnUpdate();
+			picks.emplace_back(m_ClickPickRequested ? PickKind::Click : PickKind::Hover, PixelRegion { mouse.x, mouse.y });
+			m_LastPickPosition = mouse;
 		}
-		if (m_EditorState == EditorState::Play)
+		m_ClickPickRequested = false;
+		if (m_MarqueeRequest)
 		{
-			m_CurrentScene->OnRuntimeUpdate();
+			picks.emplace_back(PickKind::Marquee, *m_MarqueeRequest);
+			m_MarqueeRequest.reset();
 		}
 
-		auto[mx, my] = ImGui::GetMousePos();
-		mx -= m_ViewportBounds.x;
-		my -= m_ViewportBounds.y;
+		const auto& spec = m_Framebuffer->GetSpecification();
+		m_RenderGraph.reset();
+		const auto sceneColor = m_RenderGraph.importTexture("SceneColor", *m_Framebuffer, 0,
+			{ FramebufferTextureFormat::RGBA8, spec.width, spec.height, 1, { 0.2f, 0.2f, 0.2f, 1.0f } });
+		const auto entityIDs = m_RenderGraph.createTexture("EntityIDs",
+			{ FramebufferTextureFormat::RED_INTEGER, spec.width, spec.height, 1, glm::vec4(-1.0f) });
+		const auto sceneDepth = m_RenderGraph.createTexture("SceneDepth",
+			{ FramebufferTextureFormat::Depth, spec.width, spec.height });
 
-		glm::vec2 viewportSize = glm::vec2(m_ViewportBounds.z - m_ViewportBounds.x, m_ViewportBounds.w - m_ViewportBounds.y);
-		my = viewportSize.y - my;
-		int mouseX = (int)mx;
-		int mouseY = (int)my;
+		m_RenderGraph.addPass("Scene", [&](RenderGraph::Builder& builder)
+		{
+			builder.write(sceneColor, true);
+			builder.write(entityIDs, true);
+			builder.writeLocal(sceneDepth);
+		}, [this](const std::shared_ptr<RenderGraphFrame>&)
+		{
+			// The scene submits its draws while it is updated, they land inside the pass
+			if (m_EditorState == EditorState::Edit)
+				m_CurrentScene->OnUpdateEditor(m_EditorCamera.GetCamera(), m_EditorCamera.GetTransform());
+			if (m_EditorState == EditorState::Play)
+				m_CurrentScene->OnRuntimeUpdate();
+		});
 
-		if (m_CurrentScene)
+		// Without picks this frame the pass is culled, and the entity id target with it
+		if (!picks.empty())
+		{
+			m_RenderGraph.addPass("Picking", [&](RenderGraph::Builder& builder)
+			{
+				builder.read(entityIDs, RenderGraphAccess::Transfer);
+				builder.sideEffect();
+			}, [this, entityIDs, picks = std::move(picks)](const std::shared_ptr<RenderGraphFrame>& frame)
+			{
+				RenderThread::submit([this, frame, entityIDs, picks]
+				{
+					for (const auto& [kind, region] : picks)
+					{
+						frame->getBackend().requestPixels(frame->getTexture(entityIDs), region);
+						m_PendingPicks.push_back(kind);
+					}
+				});
+			});
+		}
+
+		m_RenderGraph.execute();
+
+		if (m_EditorState == EditorState::Edit)
+			m_EditorCamera.OnUpdate();
+
+		RenderThread::submit([this]
 		{
-			if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y)
+			PixelRegion region;
+			std::vector<int> entityIDs;
+			while (m_RenderGraph.pollPixels(region, entityIDs))
 			{
-				int pixelData = m_Framebuffer->ReadPixel(1, mouseX, mouseY);
-				m_HoveredEntity = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_CurrentScene.get());
+				m_PickResults.push_back({ m_PendingPicks.front(), entityIDs });
+				m_PendingPicks.pop_front();
+			}
+		});
+	}
+
+	glm::ivec2 CardiaTor::ToViewportPixel(const glm::vec2& screenPosition) const
+	{
+		// Framebuffer rows go from the bottom up
+		const float viewportHeight = m_ViewportBounds.w - m_ViewportBounds.y;
+		return { static_cast<int>(screenPosition.x - m_ViewportBounds.x), static_cast<int>(viewportHeight - (screenPosition.y - m_ViewportBounds.y)) };
+	}
+
+	void CardiaTor::ResolvePick(const PickResult& result)
+	{
+		// Results can outlive the scene they were read from
+		auto& registry = m_CurrentScene->GetRegistry();
+		const auto toEntity = [&](int id)
+		{
+			const auto handle = static_cast<entt::entity>(id);
+			return id != -1 && registry.valid(handle) ? Entity(handle, m_CurrentScene.get()) : Entity();
+		};
+
+		switch (result.kind)
+		{
+			case PickKind::Hover:
+				m_HoveredEntity = toEntity(result.entityIDs.front());
+				break;
+			case PickKind::Click:
+				m_HoveredEntity = toEntity(result.entityIDs.front());
+				SelectFromViewport(m_HoveredEntity);
+				break;
+			case PickKind::Marquee:
+			{
+				std::vector<int> ids = result.entityIDs;
+				std::ranges::sort(ids);
+				const auto duplicates = std::ranges::unique(ids);
+				ids.erase(duplicates.begin(), duplicates.end());
+
+				std::vector<entt::entity> selection;
+				for (const int id : ids)
+				{
+					if (toEntity(id))
+						selection.push_back(static_cast<entt::entity>(id));
+				}
+				SelectFromViewport(selection.empty() ? Entity() : Entity(selection.front(), m_CurrentScene.get()));
+				m_MarqueeSelection = std::move(selection);
+				break;
 			}
 		}
+	}
 
-		m_Framebuffer->Unbind();
+	void CardiaTor::SelectFromViewport(Entity entity)
+	{
+		SetSelectedEntity(entity);
+		auto inspector = m_PanelManager.GetLastFocused<Panel::InspectorPanel>();
+		if (inspector)
+			inspector->SetSelectedEntity(entity);
+
+		auto sceneHierarchy = m_PanelManager.GetLastFocused<Panel::SceneHierarchyPanel>();
+		if (sceneHierarchy)
+			sceneHierarchy->SetSelectedEntity(entity);
 	}
 
 	void CardiaTor::EnableDocking()
@@ -222,6 +323,8 @@ namespace Cardia
 	{
 		m_HoveredEntity = Entity();
 		m_SelectedEntity = Entity();
+		m_MarqueeSelection.clear();
+		m_PickResults.clear();
 		for (auto& panel: m_PanelManager.Panels()) {
 			panel->OnSceneLoad(m_CurrentScene.get());
 		}
@@ -274,6 +377,13 @@ namespace Cardia
 
 	void CardiaTor::OnImGuiDraw()
 	{
+		if (m_CurrentScene)
+		{
+			for (const auto& result : m_PickResults)
+				ResolvePick(result);
+		}
+		m_PickResults.clear();
+
 		EnableDocking();
 
 		for (const auto& panel : m_PanelManager.Panels())
@@ -309,9 +419,18 @@ namespace Cardia
 
 		ImVec2 canvas_p0 = ImGui::GetCursorScreenPos();
 
+		// Only the bottom left of the attachment is drawn, it is kept larger while the panel is resized
+		const float usedU = m_SceneSize.x / static_cast<float>(m_Framebuffer->GetAttachmentWidth());
+		const float usedV = m_SceneSize.y / static_cast<float>(m_Framebuffer->GetAttachmentHeight());
 		ImGui::Image(reinterpret_cast<ImTextureID>(static_cast<size_t>(textureID)),
 			     ImVec2{m_SceneSize.x, m_SceneSize.y},
-			     ImVec2{0, 1}, ImVec2{1, 0});
+			     ImVec2{0, usedV}, ImVec2{usedU, 0});
+
+		if (m_MarqueeStart)
+		{
+			const auto [mx, my] = ImGui::GetMousePos();
+			ImGui::GetWindowDrawList()->AddRect(ImVec2(m_MarqueeStart->x, m_MarqueeStart->y), ImVec2(mx, my), IM_COL32(255, 255, 255, 200));
+		}
 
 		if (ImGui::BeginDragDropTarget())
 		{
@@ -467,16 +586,32 @@ namespace Cardia
 				if (m_SelectedEntity && ImGuizmo::IsOver()) return;
 				if (!m_HoverViewport) return;
 
-				m_SelectedEntity = m_HoveredEntity;
-				auto inspector = m_PanelManager.GetLastFocused<Panel::InspectorPanel>();
-				if (inspector)
-					inspector->SetSelectedEntity(m_HoveredEntity);
-
-				auto sceneHierarchy = m_PanelManager.GetLastFocused<Panel::SceneHierarchyPanel>();
-				if (sceneHierarchy)
-					sceneHierarchy->SetSelectedEntity(m_HoveredEntity);
+				// Selected once the id under the cursor is read back, a drag turns it into a marquee
+				m_ClickPickRequested = true;
+				const auto [mx, my] = ImGui::GetMousePos();
+				m_MarqueeStart = glm::vec2(mx, my);
 			}
 		});
+
+		dispatcher.dispatch<MouseButtonUpEvent>([this](const MouseButtonUpEvent& e)
+		{
+			if (e.getButton() != Mouse::Left || !m_MarqueeStart)
+				return;
+
+			const auto [mx, my] = ImGui::GetMousePos();
+			const glm::ivec2 start = ToViewportPixel(*m_MarqueeStart);
+			const glm::ivec2 end = ToViewportPixel({ mx, my });
+			m_MarqueeStart.reset();
+
+			constexpr int minMarqueeSize = 4;
+			if (std::abs(end.x - start.x) < minMarqueeSize && std::abs(end.y - start.y) < minMarqueeSize)
+				return;
+
+			const glm::ivec2 maxPixel = glm::ivec2(m_SceneSize) - 1;
+			const glm::ivec2 min = glm::clamp(glm::min(start, end), glm::ivec2(0), maxPixel);
+			const glm::ivec2 max = glm::clamp(glm::max(start, end), glm::ivec2(0), maxPixel);
+			m_MarqueeRequest = PixelRegion { min.x, min.y, max.x - min.x + 1, max.y - min.y + 1 };
+		});
 	}
 
 	void CardiaTor::AddCommand(std::unique_ptr<Command> command) {
@@ -509,5 +644,11 @@ namespace Cardia
 	void CardiaTor::SetSelectedEntity(Entity entity)
 	{
 		m_SelectedEntity = entity;
+		m_MarqueeSelection.clear();
+	}
+
+	bool CardiaTor::IsSelected(entt::entity entity) const
+	{
+		return m_SelectedEntity == entity || std::ranges::find(m_MarqueeSelection, entity) != m_MarqueeSelection.end();
 	}
 }
@@ -5,5 +5,11 @@
 
 std::unique_ptr<Cardia::Application> Cardia::CreateApplication()
 {
+	// The editor is built on ImGui, which headless runs never create
+	if (Application::isHeadless())
+	{
+		Log::coreError("CardiaTor needs a window, run the Benchmark target for --headless and --null-renderer");
+		return nullptr;
+	}
 	return std::make_unique<CardiaTor>();
 }
@@ -4,9 +4,11 @@
 
 #include "Cardia/Application.hpp"
 #include "Cardia/Core/Window.hpp"
+#include "Cardia/Renderer/GpuProfiler.hpp"
 #include "Cardia/Renderer/RenderAPI.hpp"
 #include "Cardia/Renderer/Renderer2D.hpp"
 #include "Panels/PanelManager.hpp"
+#include "CardiaTor.hpp"
 
 
 namespace Cardia::Panel
@@ -69,6 +71,28 @@ namespace Cardia::Panel
 				ImGui::LabelText(
 					std::to_string(Renderer2D::getStats().triangleCount).c_str(),
 					"Triangle Count");
+				ImGui::LabelText(
+					std::to_string(Renderer2D::getStats().culledCount).c_str(),
+					"Culled Objects");
+				ImGui::LabelText(
+					std::to_string(Renderer2D::getStats().stateChanges).c_str(),
+					"State Changes");
+				ImGui::LabelText(
+					std::to_string(Renderer2D::getStats().elidedStateChanges).c_str(),
+					"Elided State Changes");
+				ImGui::Separator();
+				// Read back a frame or two late, the CPU never waits for the GPU to get them
+				const auto& profiler = GpuProfiler::get();
+				ImGui::Text("GPU Time (ms)");
+				ImGui::Text("Lights upload : %.3f", profiler.getMilliseconds(GpuPass::LightsUpload));
+				ImGui::Text("Sprites       : %.3f", profiler.getMilliseconds(GpuPass::Sprites));
+				ImGui::Text("Meshes        : %.3f", profiler.getMilliseconds(GpuPass::Meshes));
+				ImGui::Text("ImGui         : %.3f", profiler.getMilliseconds(GpuPass::ImGui));
+				ImGui::Separator();
+				const auto& renderGraph = appContext->GetRenderGraph();
+				ImGui::Text("Render Graph");
+				ImGui::Text("Passes   : %u / %u", renderGraph.getKeptPassCount(), renderGraph.getPassCount());
+				ImGui::Text("Textures : %u", renderGraph.getPhysicalTextureCount());
 				ImGui::Separator();
 				ImGui::Text("GPU's Info");
 				ImGui::Text("Vendor   : %s", RenderAPI::get().getVendor().c_str());
@@ -85,6 +109,28 @@ namespace Cardia::Panel
 				ImGui::Checkbox("Wireframe rendering?", &isWireframeMode);
 				RenderAPI::get().setWireFrame(isWireframeMode);
 
+				bool isInstancedSprites = Renderer2D::isInstancedSprites();
+				if (ImGui::Checkbox("Instanced sprites?", &isInstancedSprites))
+					Renderer2D::setInstancedSprites(isInstancedSprites);
+
+				bool isRetainedSprites = Renderer2D::isRetainedSprites();
+				if (ImGui::Checkbox("Retained sprites?", &isRetainedSprites))
+					Renderer2D::setRetainedSprites(isRetainedSprites);
+
+				bool isTopDownSorting = Renderer2D::isTopDownSorting();
+				if (ImGui::Checkbox("Top-down sprite sorting?", &isTopDownSorting))
+					Renderer2D::setTopDownSorting(isTopDownSorting);
+
+				// Scene cameras have their own toggle in the inspector
+				auto& editorCamera = appContext->GetEditorCamera().GetCamera();
+				bool isDepthPrePass = editorCamera.isDepthPrePass();
+				if (ImGui::Checkbox("Editor depth pre-pass?", &isDepthPrePass))
+					editorCamera.setDepthPrePass(isDepthPrePass);
+
+				bool isGpuCulling = Renderer2D::isGpuCulling();
+				if (ImGui::Checkbox("GPU culling?", &isGpuCulling))
+					Renderer2D::setGpuCulling(isGpuCulling);
+
 				ImGui::Checkbox("Fullscreen?", &isFullscreen);
 				if (isFullscreen != isFullscreenPrev)
 				{
@@ -8,6 +8,7 @@
 #include "Cardia/Application.hpp"
 #include "Panels/PanelManager.hpp"
 #include "Cardia/Project/Project.hpp"
+#include "Cardia/Renderer/TextureAtlas.hpp"
 
 namespace Cardia::Panel
 {
@@ -87,6 +88,13 @@ namespace Cardia::Panel
 			{
 				m_CurrentPath /= path;
 			}
+			// Import step, the atlas is written next to the folder and picked up on the next listing
+			if (ImGui::BeginPopupContextItem())
+			{
+				if (ImGui::MenuItem("Pack Atlas"))
+					TextureAtlas::pack(entry.path(), m_CurrentPath / (path + ".atlas"));
+				ImGui::EndPopup();
+			}
 			ImGui::PopStyleColor();
 
 			ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetColumnWidth() / 2.0f - ImGui::CalcTextSize(path.c_str()).x / 2.0f + ImGui::GetStyle().ItemSpacing.x / 2);
@@ -78,22 +78,50 @@ namespace Cardia::Panel
 			const auto white = Texture2D::create(1, 1, &whiteColor);
 			const auto texID = sprite.texture ? sprite.texture->getRendererID() : white->getRendererID();
 
-			ImGui::Image(reinterpret_cast<ImTextureID>(static_cast<size_t>(texID)), {15, 15}, {0, 1}, {1, 0});
+			const auto& uv = sprite.uvRect;
+			ImGui::Image(reinterpret_cast<ImTextureID>(static_cast<size_t>(texID)), {15, 15}, {uv.x, uv.y + uv.w}, {uv.x + uv.z, uv.y});
 			if (ImGui::BeginDragDropTarget())
 			{
 				if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("FILE_PATH"))
 				{
 					const auto* cStrPath = static_cast<const char*>(payload->Data);
-					auto tex = AssetsManager::Load<Texture2D>(cStrPath);
-					if (tex->isLoaded())
+					if (std::filesystem::path(cStrPath).extension() == ".atlas")
 					{
-						sprite.texture = std::move(tex);
+						// First region until another one is picked below
+						auto atlas = AssetsManager::Load<TextureAtlas>(cStrPath);
+						if (!atlas->getRegions().empty())
+							sprite.setRegion(atlas, atlas->getRegions().begin()->first);
+					}
+					else
+					{
+						auto tex = AssetsManager::Load<Texture2D>(cStrPath);
+						if (tex->isLoaded())
+						{
+							sprite.texture = std::move(tex);
+							sprite.uvRect = fullTextureRect;
+							sprite.atlas = nullptr;
+							sprite.region.clear();
+						}
 					}
 				}
 				ImGui::EndDragDropTarget();
 			}
 			ImGui::SameLine();
 			ImGui::Text("Texture");
+
+			if (sprite.atlas && ImGui::BeginCombo("Region", sprite.region.c_str()))
+			{
+				std::vector<std::string> names;
+				for (const auto& [name, region] : sprite.atlas->getRegions())
+					names.push_back(name);
+				std::ranges::sort(names);
+				for (const auto& name : names)
+				{
+					if (ImGui::Selectable(name.c_str(), name == sprite.region))
+						sprite.setRegion(sprite.atlas, name);
+				}
+				ImGui::EndCombo();
+			}
 			EditorUI::DragInt("zIndex", &sprite.zIndex, 0.05f);
 		});
 
@@ -112,11 +140,18 @@ namespace Cardia::Panel
 				{
 					auto path = std::filesystem::path(static_cast<const char*>(payload->Data));
 					auto mesh = AssetsManager::Load<Mesh>(path);
-					meshRendererC.meshRenderer->SubmitMesh(mesh);
+					meshRendererC.meshRenderer->SubmitMesh(mesh, meshRendererC.meshRenderer->GetVertexFormat());
 				}
 				ImGui::EndDragDropTarget();
 			}
 
+			bool packedVertices = meshRendererC.meshRenderer->GetVertexFormat() == VertexFormat::Packed;
+			if (EditorUI::Checkbox("Packed vertices", &packedVertices) && meshRendererC.meshRenderer->GetMesh())
+			{
+				meshRendererC.meshRenderer->SubmitMesh(meshRendererC.meshRenderer->GetMesh(),
+								       packedVertices ? VertexFormat::Packed : VertexFormat::Standard);
+			}
+
 			uint32_t whiteColor = 0xffffffff;
 			static const auto white = Texture2D::create(1, 1, &whiteColor);
 
@@ -165,6 +200,10 @@ namespace Cardia::Panel
 
 			EditorUI::Checkbox("Primary", &isPrimary);
 
+			bool depthPrePass = cam.isDepthPrePass();
+			if (EditorUI::Checkbox("Depth Pre-Pass", &depthPrePass))
+				cam.setDepthPrePass(depthPrePass);
+
 			if (cam.GetProjectionType() == SceneCamera::ProjectionType::Perspective) {
 				auto perspective = cam.GetPerspective();
 
@@ -40,7 +40,7 @@ namespace Cardia :: Panel
 		{
 			auto name = view.get<Component::Name>(entity);
 			auto uuid = view.get<Component::ID>(entity);
-			auto node_flags = ((m_SelectedEntity == entity) ? ImGuiTreeNodeFlags_Selected : 0);
+			auto node_flags = ((m_SelectedEntity == entity || appContext->IsSelected(entity)) ? ImGuiTreeNodeFlags_Selected : 0);
 			node_flags |= ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_Leaf;
 			//node_flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
 			if (ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<uint64_t>(static_cast<uint32_t>(entity))), node_flags, "%s", name.name.c_str())) {
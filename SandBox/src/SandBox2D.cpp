@@ -45,8 +45,11 @@ void SandBox2D::OnUpdate()
 		snakePos.emplace_front(head.x + vx, head.y + vy, head.z);
 	}
 
-	Cardia::RenderAPI::get().setClearColor({0.2f, 0.2f, 0.2f, 1});
-	Cardia::RenderAPI::get().clear();
+	Cardia::RenderThread::submit([]
+	{
+		Cardia::RenderAPI::get().setClearColor({0.2f, 0.2f, 0.2f, 1});
+		Cardia::RenderAPI::get().clear();
+	});
 }
 
 void SandBox2D::OnImGuiDraw()
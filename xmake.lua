@@ -60,6 +60,10 @@ target("Cardia")
     add_packages("python", { public = true })
     add_packages("pybind11", { public = true })
 
+    if is_plat("linux") then
+        add_syslinks("EGL", { public = true }) -- Headless contexts
+    end
+
 --[[    after_build(function(target)
         os.execv("python", {"-m", "pip", "install", target:scriptdir().."/cardia.py/dist/cardia.py-0.0.1-py3-none-any.whl", "--force-reinstall"})
     end)
@@ -118,3 +122,21 @@ target("CardiaTor")
     if is_mode("debug") then
         add_defines("CD_DEBUG")
     end
+
+target("Benchmark")
+    set_kind("binary")
+    set_runtimes("MT")
+
+    set_targetdir("build/" .. outputdir .. "/Benchmark/bin")
+    set_objectdir("build/" .. outputdir .. "/Benchmark/obj")
+
+    add_headerfiles("Benchmark/include/**.hpp")
+    add_files("Benchmark/src/**.cpp")
+    add_includedirs("Benchmark/include/", {public = true})
+    set_rundir("CardiaTor/") -- the engine shaders live with the editor
+
+    add_deps("Cardia")
+
+    if is_mode("debug") then
+        add_defines("CD_DEBUG")
+    end